@@ -26022,6 +26022,7 @@ namespace csp
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <chrono>
 #include <climits>
 #include <cmath>
 #include <cstddef>
@@ -26038,6 +26039,7 @@ namespace csp
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -26788,7 +26790,7 @@ namespace csd
 
     struct audio_reader
     {
-      const std::vector<std::byte> &bytes;
+      std::span<const std::byte> bytes;
       const std::filesystem::path &file;
       std::size_t cursor{};
 
@@ -26800,15 +26802,15 @@ namespace csd
       std::uint8_t byte()
       {
         require(1);
-        return static_cast<std::uint8_t>(bytes.at(cursor++));
+        return static_cast<std::uint8_t>(bytes[cursor++]);
       }
       std::uint32_t dword()
       {
         require(4);
-        const auto value{static_cast<std::uint32_t>(bytes.at(cursor)) |
-                         static_cast<std::uint32_t>(bytes.at(cursor + 1)) << 8u |
-                         static_cast<std::uint32_t>(bytes.at(cursor + 2)) << 16u |
-                         static_cast<std::uint32_t>(bytes.at(cursor + 3)) << 24u};
+        const auto value{static_cast<std::uint32_t>(bytes[cursor]) |
+                         static_cast<std::uint32_t>(bytes[cursor + 1]) << 8u |
+                         static_cast<std::uint32_t>(bytes[cursor + 2]) << 16u |
+                         static_cast<std::uint32_t>(bytes[cursor + 3]) << 24u};
         cursor += 4;
         return value;
       }
@@ -26831,7 +26833,7 @@ namespace csd
       {
         if (cursor + magic.size() > bytes.size()) return false;
         for (std::size_t index{}; index < magic.size(); ++index)
-          if (static_cast<char>(bytes.at(cursor + index)) != magic.at(index)) return false;
+          if (static_cast<char>(bytes[cursor + index]) != magic.at(index)) return false;
         return true;
       }
       void skip(const std::size_t count)
@@ -26851,7 +26853,7 @@ namespace csd
       std::vector<std::uint8_t> lacings{};
     };
 
-    inline std::vector<ogg_page> ogg_pages(const std::vector<std::byte> &bytes, const std::filesystem::path &file)
+    inline std::vector<ogg_page> ogg_pages(const std::span<const std::byte> bytes, const std::filesystem::path &file)
     {
       std::vector<ogg_page> pages{};
       audio_reader reader{bytes, file};
@@ -26883,7 +26885,7 @@ namespace csd
       return pages;
     }
 
-    inline std::pair<std::vector<std::byte>, std::size_t> ogg_opus_tags(const std::vector<std::byte> &bytes,
+    inline std::pair<std::vector<std::byte>, std::size_t> ogg_opus_tags(const std::span<const std::byte> bytes,
                                                                         const std::vector<ogg_page> &pages,
                                                                         const std::filesystem::path &file)
     {
@@ -26996,7 +26998,7 @@ namespace csd
       }
     }
 
-    inline void append_ogg_page(std::vector<std::byte> &output, const std::vector<std::byte> &bytes,
+    inline void append_ogg_page(std::vector<std::byte> &output, const std::span<const std::byte> bytes,
                                 const ogg_page &page, std::uint32_t &sequence)
     {
       const auto start{output.size()};
@@ -27007,7 +27009,7 @@ namespace csd
       place_dword(output, start + 22u, ogg_page_checksum(std::span{output}.subspan(start)));
     }
 
-    inline std::optional<std::vector<std::byte>> opus_extract_rpp(const std::vector<std::byte> &bytes,
+    inline std::optional<std::vector<std::byte>> opus_extract_rpp(const std::span<const std::byte> bytes,
                                                                   const std::vector<ogg_page> &pages,
                                                                   const std::filesystem::path &file)
     {
@@ -27019,7 +27021,7 @@ namespace csd
       return std::nullopt;
     }
 
-    inline std::vector<std::byte> opus_replace_rpp(const std::vector<std::byte> &bytes,
+    inline std::vector<std::byte> opus_replace_rpp(const std::span<const std::byte> bytes,
                                                    const std::vector<ogg_page> &pages,
                                                    const std::optional<std::vector<std::byte>> &project,
                                                    const std::filesystem::path &file)
@@ -27062,7 +27064,7 @@ namespace csd
       return output;
     }
 
-    inline std::optional<std::vector<std::byte>> wav_extract_rpp(const std::vector<std::byte> &bytes,
+    inline std::optional<std::vector<std::byte>> wav_extract_rpp(const std::span<const std::byte> bytes,
                                                                  const std::filesystem::path &file)
     {
       audio_reader reader{bytes, file};
@@ -27077,7 +27079,7 @@ namespace csd
       return std::nullopt;
     }
 
-    inline std::vector<std::byte> wav_replace_rpp(const std::vector<std::byte> &bytes,
+    inline std::vector<std::byte> wav_replace_rpp(const std::span<const std::byte> bytes,
                                                   const std::optional<std::vector<std::byte>> &project,
                                                   const std::filesystem::path &file)
     {
@@ -27106,7 +27108,7 @@ namespace csd
       return output;
     }
 
-    inline bool wave_audio(const std::vector<std::byte> &bytes, const std::filesystem::path &file)
+    inline bool wave_audio(const std::span<const std::byte> bytes, const std::filesystem::path &file)
     {
       audio_reader reader{bytes, file};
       if (!reader.matches("RIFF")) return false;
@@ -27114,7 +27116,7 @@ namespace csd
       return reader.matches("WAVE");
     }
 
-    inline std::optional<std::vector<std::byte>> audio_extract_rpp(const std::vector<std::byte> &bytes,
+    inline std::optional<std::vector<std::byte>> audio_extract_rpp(const std::span<const std::byte> bytes,
                                                                    const std::filesystem::path &file)
     {
       audio_reader reader{bytes, file};
@@ -27129,7 +27131,7 @@ namespace csd
       return std::nullopt;
     }
 
-    inline std::vector<std::byte> audio_replace_rpp(const std::vector<std::byte> &bytes,
+    inline std::vector<std::byte> audio_replace_rpp(const std::span<const std::byte> bytes,
                                                     const std::optional<std::vector<std::byte>> &project,
                                                     const std::filesystem::path &file)
     {
@@ -27145,22 +27147,13 @@ namespace csd
       throw std::runtime_error("Audio file must be Opus or WAV to carry a Reaper project: " + file.string() + ".");
     }
 
-    inline aseprite read_aseprite(const std::filesystem::path &file)
+    inline aseprite read_aseprite(const std::span<const std::byte> data, const std::filesystem::path &file)
     {
-      if (!std::filesystem::exists(file)) throw std::runtime_error("File does not exist: " + file.string());
-      std::ifstream input(file, std::ios::binary);
-      if (!input.is_open()) throw std::runtime_error("Failed to open file: " + file.string());
-      input.seekg(0, std::ios::end);
-      const std::streamsize total{input.tellg()};
-      input.seekg(0, std::ios::beg);
-      std::vector<unsigned char> bytes(static_cast<std::size_t>(total));
-      if (total > 0 && !input.read(reinterpret_cast<char *>(bytes.data()), total))
-        throw std::runtime_error("Failed to read file: " + file.string());
-      input.close();
+      const std::span<const unsigned char> bytes{reinterpret_cast<const unsigned char *>(data.data()), data.size()};
 
       struct reader_state
       {
-        const std::vector<unsigned char> &bytes;
+        std::span<const unsigned char> bytes;
         const std::filesystem::path &file;
         std::size_t cursor{};
 
@@ -27172,23 +27165,23 @@ namespace csd
         std::uint8_t byte()
         {
           require(1);
-          return bytes.at(cursor++);
+          return bytes[cursor++];
         }
         std::uint16_t word()
         {
           require(2);
-          const auto value(static_cast<std::uint16_t>(static_cast<std::uint32_t>(bytes.at(cursor)) |
-                                                      static_cast<std::uint32_t>(bytes.at(cursor + 1)) << 8u));
+          const auto value(static_cast<std::uint16_t>(static_cast<std::uint32_t>(bytes[cursor]) |
+                                                      static_cast<std::uint32_t>(bytes[cursor + 1]) << 8u));
           cursor += 2;
           return value;
         }
         std::uint32_t dword()
         {
           require(4);
-          const auto value(static_cast<std::uint32_t>(bytes.at(cursor)) |
-                           static_cast<std::uint32_t>(bytes.at(cursor + 1)) << 8u |
-                           static_cast<std::uint32_t>(bytes.at(cursor + 2)) << 16u |
-                           static_cast<std::uint32_t>(bytes.at(cursor + 3)) << 24u);
+          const auto value(static_cast<std::uint32_t>(bytes[cursor]) |
+                           static_cast<std::uint32_t>(bytes[cursor + 1]) << 8u |
+                           static_cast<std::uint32_t>(bytes[cursor + 2]) << 16u |
+                           static_cast<std::uint32_t>(bytes[cursor + 3]) << 24u);
           cursor += 4;
           return value;
         }
@@ -27840,7 +27833,7 @@ namespace csd
    * Opus files store the project in an "RPP_SOURCE" comment tag and wav files store it in an "rpp " chunk; both are
    * ignored by audio decoders. Files that are not Opus or WAV yield nothing.
    */
-  inline std::optional<std::vector<std::byte>> audio_extract_rpp(const std::vector<std::byte> &bytes,
+  inline std::optional<std::vector<std::byte>> audio_extract_rpp(const std::span<const std::byte> bytes,
                                                                  const std::filesystem::path &file)
   { return detail::audio_extract_rpp(bytes, file); }
 
@@ -27848,7 +27841,7 @@ namespace csd
    * Replaces the Reaper project embedded in an opus/wav audio file, embedding the given project or stripping any
    * embedded project when none is given. Returns the rewritten audio file.
    */
-  inline std::vector<std::byte> audio_replace_rpp(const std::vector<std::byte> &bytes,
+  inline std::vector<std::byte> audio_replace_rpp(const std::span<const std::byte> bytes,
                                                   const std::optional<std::vector<std::byte>> &project,
                                                   const std::filesystem::path &file)
   { return detail::audio_replace_rpp(bytes, project, file); }
@@ -27865,9 +27858,10 @@ namespace csd
    * | `name`: The accessor name of the resource (usually the file stem).
    * | `space`: The resource kind: "image", "font", "sound" or "music".
    * | `pack`: The name of the csp pack the resource belongs to.
+   * | `bytes`: The contents of the file, for callers that already hold them, such as a mapped view.
    */
   inline resource load(const std::filesystem::path &file, const std::string &name, const std::string &space,
-                       const std::string &pack)
+                       const std::string &pack, const std::span<const std::byte> bytes)
   {
     resource current{};
     current.file = file;
@@ -27876,7 +27870,7 @@ namespace csd
     current.pack = pack;
     if (space == "image" || space == "font")
     {
-      auto texture{detail::read_aseprite(file)};
+      auto texture{detail::read_aseprite(bytes, file)};
       if (space == "image" && !texture.pivot)
         throw std::runtime_error("Texture is missing the required 'pivot' group: " + file.string());
       if (space == "font")
@@ -27896,13 +27890,18 @@ namespace csd
     }
     else if (space == "sound" || space == "music")
     {
-      current.blob = detail::read_bytes(file);
-      if (audio_extract_rpp(current.blob, file)) current.blob = audio_replace_rpp(current.blob, std::nullopt, file);
+      if (audio_extract_rpp(bytes, file))
+        current.blob = audio_replace_rpp(bytes, std::nullopt, file);
+      else
+        current.blob.assign(bytes.begin(), bytes.end());
     }
     else
       throw std::runtime_error("Unknown resource space '" + space + "' for file: " + file.string() + ".");
     return current;
   }
+  inline resource load(const std::filesystem::path &file, const std::string &name, const std::string &space,
+                       const std::string &pack)
+  { return load(file, name, space, pack, detail::read_bytes(file)); }
 
   /**
    * Returns the preamble of the generated accessor header and source files.
@@ -28232,6 +28231,7 @@ namespace csd
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <charconv>
 #include <cmath>
 #include <concepts>
 #include <cstddef>
@@ -28249,9 +28249,11 @@ namespace csd
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <regex>
+#include <shared_mutex>
 #include <span>
 #include <sstream>
 #include <stdexcept>
@@ -28339,6 +28341,60 @@ inline int terminal_width()
   }
 }
 
+inline std::optional<std::vector<std::optional<std::filesystem::file_time_type>>>
+batched_write_times(const std::vector<std::filesystem::path> &)
+{ return std::nullopt; }
+
+class change_watcher
+{
+public:
+  change_watcher() { throw std::runtime_error("Watching for changes is only supported on Linux."); }
+  void watch(const std::vector<std::filesystem::path> &) {}
+  std::vector<std::pair<std::filesystem::path, bool>> wait(const std::chrono::milliseconds) { return {}; }
+};
+
+// Maps a file into memory read only, returning an empty view for an empty file or nothing if it cannot be mapped.
+inline std::optional<std::span<const std::byte>> map_file_view(const std::filesystem::path &file)
+{
+  void *handle{CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, nullptr)};
+  if (handle == INVALID_HANDLE_VALUE) return std::nullopt;
+  LARGE_INTEGER bytes{};
+  const bool sized{GetFileSizeEx(handle, &bytes) != 0};
+  if (!sized || bytes.QuadPart == 0)
+  {
+    CloseHandle(handle);
+    if (!sized) return std::nullopt;
+    return std::span<const std::byte>{};
+  }
+  void *map{CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+  CloseHandle(handle);
+  if (!map) return std::nullopt;
+  const void *view{MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0)};
+  CloseHandle(map);
+  if (!view) return std::nullopt;
+  return std::span<const std::byte>{static_cast<const std::byte *>(view), static_cast<std::size_t>(bytes.QuadPart)};
+}
+
+inline void unmap_file_view(const std::span<const std::byte> view)
+{
+  if (!view.empty()) UnmapViewOfFile(view.data());
+}
+
+inline std::optional<std::vector<std::pair<std::string, bool>>> directory_listing(const std::filesystem::path &)
+{ return std::nullopt; }
+
+inline bool clone_file(const std::filesystem::path &, const std::filesystem::path &) { return false; }
+
+inline std::optional<int> delegate_request(const std::string &, const std::vector<std::string> &)
+{ return std::nullopt; }
+
+inline void serve_requests(const std::string &,
+                           const std::function<std::pair<int, bool>(const std::vector<std::string> &)> &)
+{ throw std::runtime_error("The csb daemon is only supported on Linux."); }
+
+inline bool detach_process() { throw std::runtime_error("The csb daemon is only supported on Linux."); }
+
 #elif defined(__linux__)
 
   #if defined(__x86_64__) || defined(__amd64__)
@@ -28354,7 +28410,19 @@ constexpr std::string_view ARCHITECTURE{"unknown"};
   #endif
 constexpr platform PLATFORM{LINUX};
 
+  #include <csignal>
+  #include <dirent.h>
+  #include <fcntl.h>
+  #include <linux/fs.h>
+  #include <linux/io_uring.h>
+  #include <poll.h>
+  #include <sys/inotify.h>
   #include <sys/ioctl.h>
+  #include <sys/mman.h>
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <sys/syscall.h>
+  #include <sys/un.h>
   #include <unistd.h>
 
 inline std::string get_env(const std::string &name, const std::string &error_message)
@@ -28393,9 +28461,582 @@ inline int terminal_width()
   }
 }
 
+/**
+ * Reads the modification times of many files with statx requests submitted through io_uring in large batches, which
+ * avoids a system call per file. A file that does not exist has no time. Returns nothing when io_uring or its statx
+ * operation is unavailable, so the caller can fall back to reading the times another way.
+ */
+inline std::optional<std::vector<std::optional<std::filesystem::file_time_type>>>
+batched_write_times(const std::vector<std::filesystem::path> &paths)
+{
+  io_uring_params params{};
+  const int ring{static_cast<int>(syscall(__NR_io_uring_setup, 256, &params))};
+  if (ring < 0) return std::nullopt;
+  const size_t submission_size{params.sq_off.array + params.sq_entries * sizeof(unsigned)};
+  const size_t completion_size{params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe)};
+  const size_t entries_size{params.sq_entries * sizeof(io_uring_sqe)};
+  auto *submission_ring{static_cast<char *>(
+    mmap(nullptr, submission_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING))};
+  auto *completion_ring{static_cast<char *>(
+    mmap(nullptr, completion_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING))};
+  auto *entries{static_cast<io_uring_sqe *>(
+    mmap(nullptr, entries_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES))};
+  auto release{[&]()
+               {
+                 if (submission_ring != MAP_FAILED) munmap(submission_ring, submission_size);
+                 if (completion_ring != MAP_FAILED) munmap(completion_ring, completion_size);
+                 if (entries != MAP_FAILED) munmap(entries, entries_size);
+                 close(ring);
+               }};
+  if (submission_ring == MAP_FAILED || completion_ring == MAP_FAILED || entries == MAP_FAILED)
+  {
+    release();
+    return std::nullopt;
+  }
+
+  auto *submission_tail{reinterpret_cast<unsigned *>(submission_ring + params.sq_off.tail)};
+  const unsigned submission_mask{*reinterpret_cast<unsigned *>(submission_ring + params.sq_off.ring_mask)};
+  auto *submission_array{reinterpret_cast<unsigned *>(submission_ring + params.sq_off.array)};
+  auto *completion_head{reinterpret_cast<unsigned *>(completion_ring + params.cq_off.head)};
+  auto *completion_tail{reinterpret_cast<unsigned *>(completion_ring + params.cq_off.tail)};
+  const unsigned completion_mask{*reinterpret_cast<unsigned *>(completion_ring + params.cq_off.ring_mask)};
+  auto *completions{reinterpret_cast<io_uring_cqe *>(completion_ring + params.cq_off.cqes)};
+
+  std::vector<std::optional<std::filesystem::file_time_type>> times(paths.size());
+  std::vector<struct statx> results(params.sq_entries);
+  std::vector<size_t> retries{};
+  bool unsupported{};
+  for (size_t start{}; start < paths.size() && !unsupported; start += params.sq_entries)
+  {
+    const auto count{static_cast<unsigned>(std::min<size_t>(params.sq_entries, paths.size() - start))};
+    const unsigned tail{*submission_tail};
+    for (unsigned index{}; index < count; ++index)
+    {
+      auto &entry{entries[index]};
+      entry = {};
+      entry.opcode = IORING_OP_STATX;
+      entry.fd = AT_FDCWD;
+      entry.addr = reinterpret_cast<std::uint64_t>(paths.at(start + index).c_str());
+      entry.len = STATX_MTIME;
+      entry.off = reinterpret_cast<std::uint64_t>(&results.at(index));
+      entry.user_data = index;
+      submission_array[(tail + index) & submission_mask] = index;
+    }
+    __atomic_store_n(submission_tail, tail + count, __ATOMIC_RELEASE);
+
+    // The kernel may consume fewer entries than asked for, which stay queued in the ring until they are submitted too.
+    unsigned submitted{};
+    while (submitted < count && !unsupported)
+    {
+      const long result{syscall(__NR_io_uring_enter, ring, count - submitted, 0, 0, nullptr, 0)};
+      if (result < 0 && errno == EINTR) continue;
+      if (result <= 0)
+        unsupported = true;
+      else
+        submitted += static_cast<unsigned>(result);
+    }
+
+    // Whatever was submitted is reaped even after a failure, as the kernel still writes into the results.
+    for (unsigned completed{}; completed < submitted;)
+    {
+      unsigned head{*completion_head};
+      if (head == __atomic_load_n(completion_tail, __ATOMIC_ACQUIRE))
+      {
+        if (syscall(__NR_io_uring_enter, ring, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+        {
+          unsupported = true;
+          break;
+        }
+        continue;
+      }
+      for (; head != __atomic_load_n(completion_tail, __ATOMIC_ACQUIRE); ++head, ++completed)
+      {
+        const auto &completion{completions[head & completion_mask]};
+        const auto index{static_cast<size_t>(completion.user_data)};
+        if (completion.res == 0)
+        {
+          const auto &modified{results.at(index).stx_mtime};
+          times.at(start + index) = std::chrono::time_point_cast<std::filesystem::file_time_type::duration>(
+            std::chrono::file_clock::from_sys(std::chrono::sys_time<std::chrono::nanoseconds>{
+              std::chrono::seconds{modified.tv_sec} + std::chrono::nanoseconds{modified.tv_nsec}}));
+        }
+        else if (completion.res == -EINVAL || completion.res == -EOPNOTSUPP)
+          unsupported = true;
+        else if (completion.res != -ENOENT && completion.res != -ENOTDIR)
+          retries.push_back(start + index);
+      }
+      __atomic_store_n(completion_head, head, __ATOMIC_RELEASE);
+    }
+  }
+  release();
+  if (unsupported) return std::nullopt;
+
+  for (const auto index : retries)
+  {
+    std::error_code error{};
+    const auto time{std::filesystem::last_write_time(paths.at(index), error)};
+    if (!error) times.at(index) = time;
+  }
+  return times;
+}
+
+/**
+ * Watches directories for changes through one inotify instance that lives as long as the watcher, so changes made
+ * between two waits are reported by the next one. Directories created inside watched ones are watched as well.
+ */
+class change_watcher
+{
+public:
+  change_watcher() : notifier{inotify_init1(IN_CLOEXEC)}
+  {
+    if (notifier < 0) throw std::runtime_error("Failed to start watching for changes.");
+  }
+  change_watcher(const change_watcher &) = delete;
+  change_watcher &operator=(const change_watcher &) = delete;
+  ~change_watcher() { close(notifier); }
+
+  // Watches the given directories and those created inside watched ones since, removing every other watch.
+  void watch(const std::vector<std::filesystem::path> &directories)
+  {
+    const std::unordered_set<std::filesystem::path> wanted(directories.begin(), directories.end());
+    for (auto iterator{watches.begin()}; iterator != watches.end();)
+    {
+      if (wanted.contains(iterator->second) || created.contains(iterator->second))
+      {
+        ++iterator;
+        continue;
+      }
+      inotify_rm_watch(notifier, iterator->first);
+      iterator = watches.erase(iterator);
+    }
+    for (const auto &directory : directories) add(directory, false);
+    if (watches.empty()) throw std::runtime_error("No directories to watch for changes.");
+  }
+
+  /**
+   * Blocks until something changes inside the watched directories, then keeps collecting changes until none arrive for
+   * the debounce interval. Returns the changed paths, each paired with whether it was created, deleted or moved rather
+   * than just written to.
+   */
+  std::vector<std::pair<std::filesystem::path, bool>> wait(const std::chrono::milliseconds debounce)
+  {
+    std::vector<std::pair<std::filesystem::path, bool>> changes{};
+    alignas(inotify_event) std::array<char, 16384> buffer{};
+    int timeout{-1};
+    while (true)
+    {
+      pollfd request{notifier, POLLIN, 0};
+      const int ready{poll(&request, 1, timeout)};
+      if (ready < 0 && errno == EINTR) continue;
+      if (ready < 0) throw std::runtime_error("Failed to wait for changes.");
+      if (ready == 0) break;
+      const auto length{read(notifier, buffer.data(), buffer.size())};
+      if (length <= 0) continue;
+      for (ssize_t offset{}; offset < length;)
+      {
+        const auto *event{reinterpret_cast<const inotify_event *>(buffer.data() + offset)};
+        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        // Events were dropped from a full queue, so anything may have changed.
+        if (event->mask & IN_Q_OVERFLOW) changes.emplace_back(std::filesystem::current_path(), true);
+        const auto found{watches.find(event->wd)};
+        if (found == watches.end()) continue;
+        if (event->mask & IN_IGNORED)
+        {
+          created.erase(found->second);
+          watches.erase(found);
+          continue;
+        }
+        if (event->len == 0) continue;
+        const auto path{found->second / event->name};
+        if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) add(path, true);
+        changes.emplace_back(path, (event->mask & structural) != 0);
+      }
+      timeout = static_cast<int>(debounce.count());
+    }
+    return changes;
+  }
+
+private:
+  static constexpr std::uint32_t structural{IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO};
+  int notifier{-1};
+  std::unordered_map<int, std::filesystem::path> watches{};
+  std::unordered_set<std::filesystem::path> created{};
+
+  // Watches a directory, and for a newly created one every directory already inside it as well.
+  void add(const std::filesystem::path &directory, const bool is_created)
+  {
+    const int watch{inotify_add_watch(notifier, directory.c_str(), IN_CLOSE_WRITE | IN_ATTRIB | structural)};
+    if (watch < 0) return;
+    watches.emplace(watch, directory);
+    if (!is_created) return;
+    created.insert(directory);
+    std::error_code error{};
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+      if (entry.is_directory(error) && !entry.is_symlink(error)) add(entry.path(), true);
+  }
+};
+
+/**
+ * Reads the entries of a directory with a few large reads instead of one call per entry, keeping the names of regular
+ * files, including links to them, and of subdirectories that are not links, the latter marked true. Returns nothing if
+ * the directory cannot be read.
+ */
+inline std::optional<std::vector<std::pair<std::string, bool>>>
+directory_listing(const std::filesystem::path &directory)
+{
+  const int descriptor{open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+  if (descriptor < 0) return std::nullopt;
+  std::vector<std::pair<std::string, bool>> entries{};
+  alignas(dirent64) std::array<char, 32768> buffer{};
+  while (true)
+  {
+    const auto length{syscall(SYS_getdents64, descriptor, buffer.data(), buffer.size())};
+    if (length < 0)
+    {
+      close(descriptor);
+      return std::nullopt;
+    }
+    if (length == 0) break;
+    for (long offset{}; offset < length;)
+    {
+      const auto *entry{reinterpret_cast<const dirent64 *>(buffer.data() + offset)};
+      offset += entry->d_reclen;
+      const std::string_view name{entry->d_name};
+      if (name == "." || name == "..") continue;
+      bool is_link{entry->d_type == DT_LNK};
+      bool is_directory{entry->d_type == DT_DIR};
+      bool is_regular{entry->d_type == DT_REG};
+      struct stat status{};
+      if (entry->d_type == DT_UNKNOWN && fstatat(descriptor, entry->d_name, &status, AT_SYMLINK_NOFOLLOW) == 0)
+      {
+        is_link = S_ISLNK(status.st_mode);
+        is_directory = S_ISDIR(status.st_mode);
+        is_regular = S_ISREG(status.st_mode);
+      }
+      if (is_link) is_regular = fstatat(descriptor, entry->d_name, &status, 0) == 0 && S_ISREG(status.st_mode);
+      if (is_directory || is_regular) entries.emplace_back(name, is_directory);
+    }
+  }
+  close(descriptor);
+  return entries;
+}
+
+/**
+ * Maps a file into memory read only, returning an empty view for an empty file or nothing if it cannot be mapped. The
+ * kernel is told the view will be read front to back soon, so it reads ahead aggressively.
+ */
+inline std::optional<std::span<const std::byte>> map_file_view(const std::filesystem::path &file)
+{
+  const int descriptor{open(file.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (descriptor < 0) return std::nullopt;
+  struct stat status{};
+  const bool sized{fstat(descriptor, &status) == 0};
+  if (!sized || status.st_size == 0)
+  {
+    close(descriptor);
+    if (!sized) return std::nullopt;
+    return std::span<const std::byte>{};
+  }
+  const auto size{static_cast<std::size_t>(status.st_size)};
+  void *address{mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0)};
+  close(descriptor);
+  if (address == MAP_FAILED) return std::nullopt;
+  madvise(address, size, MADV_SEQUENTIAL);
+  madvise(address, size, MADV_WILLNEED);
+  return std::span<const std::byte>{static_cast<const std::byte *>(address), size};
+}
+
+inline void unmap_file_view(const std::span<const std::byte> view)
+{
+  if (!view.empty()) munmap(const_cast<std::byte *>(view.data()), view.size());
+}
+
+/**
+ * Copies a regular file without passing its bytes through user space, sharing the source's blocks on file systems that
+ * support it, like btrfs and XFS, and copying them in the kernel otherwise. Returns false if neither works, leaving the
+ * destination to be written some other way.
+ */
+inline bool clone_file(const std::filesystem::path &source, const std::filesystem::path &destination)
+{
+  const int input{open(source.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (input < 0) return false;
+  struct stat status{};
+  if (fstat(input, &status) != 0 || !S_ISREG(status.st_mode))
+  {
+    close(input);
+    return false;
+  }
+  const int output{open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, status.st_mode & 07777)};
+  if (output < 0)
+  {
+    close(input);
+    return false;
+  }
+  bool copied{ioctl(output, FICLONE, input) == 0};
+  if (!copied)
+  {
+    copied = true;
+    for (auto remaining{status.st_size}; remaining > 0;)
+    {
+      const auto length{copy_file_range(input, nullptr, output, nullptr, static_cast<std::size_t>(remaining), 0)};
+      if (length < 0 && errno == EINTR) continue;
+      if (length <= 0)
+      {
+        copied = false;
+        break;
+      }
+      remaining -= length;
+    }
+  }
+  fchmod(output, status.st_mode & 07777);
+  close(input);
+  close(output);
+  return copied;
+}
+
+// The exit code a daemon replies with when it is out of date, telling the client to handle the request itself.
+constexpr std::int32_t stale_daemon{-1};
+
+// Reads exactly the requested number of bytes from a descriptor, returning false if it closes or fails first.
+inline bool read_exact(const int descriptor, void *data, const size_t size)
+{
+  for (size_t done{}; done < size;)
+  {
+    const auto length{read(descriptor, static_cast<char *>(data) + done, size - done)};
+    if (length < 0 && errno == EINTR) continue;
+    if (length <= 0) return false;
+    done += static_cast<size_t>(length);
+  }
+  return true;
+}
+
+// Writes all of the given bytes to a descriptor, returning false if it fails first.
+inline bool write_exact(const int descriptor, const void *data, const size_t size)
+{
+  for (size_t done{}; done < size;)
+  {
+    const auto length{write(descriptor, static_cast<const char *>(data) + done, size - done)};
+    if (length < 0 && errno == EINTR) continue;
+    if (length <= 0) return false;
+    done += static_cast<size_t>(length);
+  }
+  return true;
+}
+
+/**
+ * Fills a unix socket address with a name in the abstract namespace, which leaves no file behind and disappears with
+ * the process that bound it. Returns the length of the address, or zero if the name does not fit.
+ */
+inline socklen_t socket_address(const std::string &name, sockaddr_un &address)
+{
+  if (name.size() + 1 > sizeof(address.sun_path)) return 0;
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path + 1, name.data(), name.size());
+  return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+}
+
+/**
+ * Hands a request to the daemon listening on a socket, passing the standard streams along so that its output goes
+ * straight to this process's terminal. Returns the exit code of the request, or nothing when no daemon is listening or
+ * the daemon is out of date, in which case the request has not been handled.
+ */
+inline std::optional<int> delegate_request(const std::string &socket_name, const std::vector<std::string> &args)
+{
+  sockaddr_un address{};
+  const auto address_size{socket_address(socket_name, address)};
+  if (address_size == 0) return std::nullopt;
+  const int connection{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+  if (connection < 0) return std::nullopt;
+  if (connect(connection, reinterpret_cast<const sockaddr *>(&address), address_size) != 0)
+  {
+    close(connection);
+    return std::nullopt;
+  }
+
+  std::string request{};
+  auto append{[&request](const std::uint32_t value)
+              { request.append(reinterpret_cast<const char *>(&value), sizeof(value)); }};
+  append(static_cast<std::uint32_t>(args.size()));
+  for (const auto &arg : args)
+  {
+    append(static_cast<std::uint32_t>(arg.size()));
+    request += arg;
+  }
+
+  const std::array<int, 3> descriptors{STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO};
+  alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(descriptors))> control{};
+  iovec block{request.data(), sizeof(std::uint32_t)};
+  msghdr message{};
+  message.msg_iov = &block;
+  message.msg_iovlen = 1;
+  message.msg_control = control.data();
+  message.msg_controllen = control.size();
+  auto *header{CMSG_FIRSTHDR(&message)};
+  header->cmsg_level = SOL_SOCKET;
+  header->cmsg_type = SCM_RIGHTS;
+  header->cmsg_len = CMSG_LEN(sizeof(descriptors));
+  std::memcpy(CMSG_DATA(header), descriptors.data(), sizeof(descriptors));
+
+  std::int32_t code{};
+  const bool handled{sendmsg(connection, &message, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(std::uint32_t)) &&
+                     write_exact(connection, request.data() + sizeof(std::uint32_t),
+                                 request.size() - sizeof(std::uint32_t)) &&
+                     read_exact(connection, &code, sizeof(code))};
+  close(connection);
+  if (!handled || code == stale_daemon) return std::nullopt;
+  return code;
+}
+
+/**
+ * Listens on a socket and hands each request to a handler with the client's standard streams in place of its own, so
+ * everything the handler and its child processes print goes to the client. The handler returns the exit code to reply
+ * with and whether to stop serving afterwards, in which case the socket is released before the reply is sent so that
+ * a client can start a new daemon right away. Connections from other users are closed unanswered, as are requests
+ * with more arguments, or longer ones, than a command line can hold.
+ */
+inline void serve_requests(const std::string &socket_name,
+                           const std::function<std::pair<int, bool>(const std::vector<std::string> &)> &handler)
+{
+  sockaddr_un address{};
+  const auto address_size{socket_address(socket_name, address)};
+  if (address_size == 0) throw std::runtime_error("Daemon socket name is too long.");
+  const int listener{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+  if (listener < 0) throw std::runtime_error("Failed to create the daemon socket.");
+  if (bind(listener, reinterpret_cast<const sockaddr *>(&address), address_size) != 0 || listen(listener, 16) != 0)
+  {
+    close(listener);
+    throw std::runtime_error("Failed to listen on the daemon socket, another daemon may be starting.");
+  }
+  std::signal(SIGPIPE, SIG_IGN);
+
+  bool serving{true};
+  while (serving)
+  {
+    const int connection{accept4(listener, nullptr, nullptr, SOCK_CLOEXEC)};
+    if (connection < 0)
+    {
+      if (errno == EINTR) continue;
+      break;
+    }
+    ucred peer{};
+    socklen_t peer_size{sizeof(peer)};
+    if (getsockopt(connection, SOL_SOCKET, SO_PEERCRED, &peer, &peer_size) != 0 || peer.uid != getuid())
+    {
+      close(connection);
+      continue;
+    }
+
+    std::uint32_t count{};
+    std::array<int, 3> descriptors{-1, -1, -1};
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(descriptors))> control{};
+    iovec block{&count, sizeof(count)};
+    msghdr message{};
+    message.msg_iov = &block;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+    bool valid{recvmsg(connection, &message, MSG_CMSG_CLOEXEC) == static_cast<ssize_t>(sizeof(count))};
+    if (const auto *header{CMSG_FIRSTHDR(&message)};
+        valid && header && header->cmsg_type == SCM_RIGHTS && header->cmsg_len == CMSG_LEN(sizeof(descriptors)))
+      std::memcpy(descriptors.data(), CMSG_DATA(header), sizeof(descriptors));
+    else
+      valid = false;
+
+    constexpr std::uint32_t argument_limit{128 * 1024};
+    constexpr std::uint32_t request_limit{2 * 1024 * 1024};
+    std::uint32_t request_size{};
+    std::vector<std::string> args{};
+    valid = valid && count <= request_limit / sizeof(count);
+    for (std::uint32_t index{}; valid && index < count; ++index)
+    {
+      std::uint32_t size{};
+      std::string arg{};
+      valid = read_exact(connection, &size, sizeof(size)) && size <= argument_limit;
+      request_size += valid ? size + static_cast<std::uint32_t>(sizeof(size)) : 0;
+      valid = valid && request_size <= request_limit;
+      if (!valid) break;
+      arg.resize(size);
+      valid = read_exact(connection, arg.data(), size);
+      args.push_back(std::move(arg));
+    }
+    if (!valid)
+    {
+      for (const int descriptor : descriptors)
+        if (descriptor >= 0) close(descriptor);
+      close(connection);
+      continue;
+    }
+
+    std::int32_t code{EXIT_FAILURE};
+    const std::array<int, 3> saved{dup(STDIN_FILENO), dup(STDOUT_FILENO), dup(STDERR_FILENO)};
+    for (int stream{}; stream < 3; ++stream) dup2(descriptors.at(static_cast<size_t>(stream)), stream);
+    std::tie(code, serving) = handler(args);
+    serving = !serving;
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    for (int stream{}; stream < 3; ++stream)
+    {
+      dup2(saved.at(static_cast<size_t>(stream)), stream);
+      close(saved.at(static_cast<size_t>(stream)));
+    }
+    for (const int descriptor : descriptors)
+      if (descriptor >= 0) close(descriptor);
+    if (!serving) close(listener);
+    write_exact(connection, &code, sizeof(code));
+    close(connection);
+  }
+  if (serving) close(listener);
+}
+
+// Moves the process into the background, returning false in the original process and true in the detached one.
+inline bool detach_process()
+{
+  std::fflush(nullptr);
+  const pid_t child{fork()};
+  if (child < 0) throw std::runtime_error("Failed to start the daemon.");
+  if (child > 0) return false;
+  setsid();
+  if (const int null_device{open("/dev/null", O_RDWR | O_CLOEXEC)}; null_device >= 0)
+  {
+    for (int stream{}; stream < 3; ++stream) dup2(null_device, stream);
+    close(null_device);
+  }
+  return true;
+}
+
 #else
 constexpr std::string_view ARCHITECTURE{"unknown"};
 constexpr platform PLATFORM{UNDEFINED};
+
+inline std::optional<std::vector<std::optional<std::filesystem::file_time_type>>>
+batched_write_times(const std::vector<std::filesystem::path> &)
+{ return std::nullopt; }
+
+class change_watcher
+{
+public:
+  change_watcher() { throw std::runtime_error("Watching for changes is only supported on Linux."); }
+  void watch(const std::vector<std::filesystem::path> &) {}
+  std::vector<std::pair<std::filesystem::path, bool>> wait(const std::chrono::milliseconds) { return {}; }
+};
+inline std::optional<std::span<const std::byte>> map_file_view(const std::filesystem::path &) { return std::nullopt; }
+
+inline void unmap_file_view(const std::span<const std::byte>) {}
+
+inline std::optional<std::vector<std::pair<std::string, bool>>> directory_listing(const std::filesystem::path &)
+{ return std::nullopt; }
+
+inline bool clone_file(const std::filesystem::path &, const std::filesystem::path &) { return false; }
+
+inline std::optional<int> delegate_request(const std::string &, const std::vector<std::string> &)
+{ return std::nullopt; }
+
+inline void serve_requests(const std::string &,
+                           const std::function<std::pair<int, bool>(const std::vector<std::string> &)> &)
+{ throw std::runtime_error("The csb daemon is only supported on Linux."); }
+
+inline bool detach_process() { throw std::runtime_error("The csb daemon is only supported on Linux."); }
 #endif
 
 enum print_stream : std::uint8_t
@@ -28407,70 +29048,471 @@ enum print_stream : std::uint8_t
 
 namespace csb
 {
+  /**
+   * A read only view of the bytes of a file, mapped into memory so that nothing is copied until the bytes are actually
+   * transformed. Files under 64 KiB, where mapping costs more than reading, and files that cannot be mapped are read
+   * into memory instead. The view stays valid for the lifetime of the object, and keeps the old bytes if the file is
+   * replaced in the meantime.
+   */
+  class mapped_file
+  {
+  public:
+    mapped_file() = default;
+    explicit mapped_file(const std::filesystem::path &file)
+    {
+      std::error_code error{};
+      const auto size{std::filesystem::file_size(file, error)};
+      if (error) throw std::runtime_error("File does not exist: " + file.string() + ".");
+      if (size >= 65536)
+        if (const auto mapped_view{map_file_view(file)})
+        {
+          view = *mapped_view;
+          mapped = true;
+          return;
+        }
+      std::ifstream input(file, std::ios::binary);
+      if (!input.is_open()) throw std::runtime_error("Failed to open file: " + file.string() + ".");
+      owned.resize(size);
+      if (size > 0 && !input.read(reinterpret_cast<char *>(owned.data()), static_cast<std::streamsize>(size)))
+        throw std::runtime_error("Failed to read file: " + file.string() + ".");
+      view = owned;
+    }
+    ~mapped_file() { release(); }
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+    mapped_file(mapped_file &&other) noexcept
+      : view{std::exchange(other.view, {})}, owned{std::move(other.owned)}, mapped{std::exchange(other.mapped, false)}
+    {
+    }
+    mapped_file &operator=(mapped_file &&other) noexcept
+    {
+      if (this == &other) return *this;
+      release();
+      view = std::exchange(other.view, {});
+      owned = std::move(other.owned);
+      mapped = std::exchange(other.mapped, false);
+      return *this;
+    }
+
+    std::span<const std::byte> bytes() const { return view; }
+    const std::byte *data() const { return view.data(); }
+    std::size_t size() const { return view.size(); }
+    bool empty() const { return view.empty(); }
+    auto begin() const { return view.begin(); }
+    auto end() const { return view.end(); }
+
+  private:
+    void release()
+    {
+      if (mapped) unmap_file_view(view);
+      view = {};
+      owned.clear();
+      mapped = false;
+    }
+
+    std::span<const std::byte> view{};
+    std::vector<std::byte> owned{};
+    bool mapped{};
+  };
+
   namespace utility
   {
     inline std::mutex output_mutex{};
     inline std::filesystem::path build_directory{};
     inline std::string last_live_execute_character{};
+    // Maps the library directory added for each compiled subproject to the subproject's build directory, which holds
+    // one output directory per configuration.
+    inline std::unordered_map<std::filesystem::path, std::filesystem::path> subproject_builds{};
 
-    inline std::string big_section_divider()
+    // Adds a directory to a list unless it is already there, since installs run again for every watch or daemon build.
+    inline void add_directory(std::vector<std::filesystem::path> &directories, const std::filesystem::path &directory)
     {
-      static const std::string divider = std::string(static_cast<size_t>(terminal_width()), '=');
-      return divider;
+      if (std::ranges::find(directories, directory) == directories.end()) directories.push_back(directory);
     }
-    inline std::string small_section_divider()
+
+    /**
+     * An ordered set of paths, which keeps deduplicating large path lists to hashed lookups instead of linear scans.
+     *
+     * Paths are compared in normal, preferred form, so "./a" and "a" are the same member, but `paths` keeps each one
+     * as it was first added, in the order it was added.
+     */
+    struct path_set
     {
-      static const std::string divider = std::string(static_cast<size_t>(terminal_width()), '-');
-      return divider;
-    }
+      std::vector<std::filesystem::path> paths{};
+      std::unordered_set<std::filesystem::path::string_type> members{};
 
-    template <typename container>
-    concept iterable = requires(container &type) {
-      std::begin(type);
-      std::end(type);
-    };
-    template <typename container>
-    concept iterable_string = requires(container &type) {
-      std::begin(type);
-      std::end(type);
-      requires std::same_as<std::remove_cvref_t<decltype(*std::begin(type))>, std::string> ||
-                 requires(decltype(*std::begin(type)) elem) {
-                   { elem.string() } -> std::convertible_to<std::string>;
-                 };
-    };
-    template <typename container>
-    concept iterable_path_dependency = requires(container &type) {
-      std::end(type);
-      std::begin(type);
-      requires std::same_as<std::remove_cvref_t<decltype(*std::begin(type))>, std::filesystem::path> ||
-                 std::same_as<std::remove_cvref_t<decltype(*std::begin(type))>,
-                              std::pair<const std::filesystem::path, std::vector<std::filesystem::path>>>;
+      // Adds a path unless the set already holds it, returning whether it was added.
+      bool insert(const std::filesystem::path &path)
+      {
+        const bool inserted{members.insert(path.lexically_normal().make_preferred().native()).second};
+        if (inserted) paths.push_back(path);
+        return inserted;
+      }
+      bool contains(const std::filesystem::path &path) const
+      { return members.contains(path.lexically_normal().make_preferred().native()); }
     };
-    template <typename tuple_type>
-    concept tuple = requires { typename std::tuple_size<tuple_type>::type; };
-    template <typename type>
-    concept serializable =
-      std::same_as<type, std::string> || std::same_as<type, std::vector<std::string>> ||
-      std::same_as<type, std::vector<std::byte>> || std::same_as<type, csp::pack> || std::same_as<type, nlohmann::json>;
-    template <typename mod, typename data_type>
-    concept modifier = requires(mod modify, const data_type &value) {
-      { modify(value) } -> std::convertible_to<data_type>;
+
+    // Whether the build runs in watch mode, where the input files that up to date checks read are recorded.
+    inline bool watching{};
+    inline path_set watched_inputs{};
+    inline std::mutex watched_inputs_mutex{};
+
+    // Records files that the build reads as inputs so that watch mode can rebuild when they change.
+    inline void record_inputs(const std::vector<std::filesystem::path> &paths)
+    {
+      if (!watching) return;
+      const std::scoped_lock<std::mutex> lock(watched_inputs_mutex);
+      for (const auto &path : paths) watched_inputs.insert(path);
+    }
+
+    // Reads the modification times of many files at once, in batches where the platform supports it and in parallel
+    // otherwise. A file that does not exist has no time. Batches only pay off when the kernel can work on several
+    // requests at the same time, so small lists and single core machines skip them.
+    inline std::vector<std::optional<std::filesystem::file_time_type>> file_write_times(
+      const std::vector<std::filesystem::path> &paths)
+    {
+      if (paths.size() >= 64 && std::thread::hardware_concurrency() > 1)
+        if (auto times{batched_write_times(paths)}) return std::move(*times);
+      std::vector<std::optional<std::filesystem::file_time_type>> times(paths.size());
+      std::transform(std::execution::par, paths.begin(), paths.end(), times.begin(),
+                     [](const std::filesystem::path &path) -> std::optional<std::filesystem::file_time_type>
+                     {
+                       std::error_code error{};
+                       const auto time{std::filesystem::last_write_time(path, error)};
+                       if (error) return std::nullopt;
+                       return time;
+                     });
+      return times;
+    }
+
+    /**
+     * Modification times of files gathered for one round of up to date checks, so that a file many checks share, like
+     * a common header, is only read once. `gather` reads the times of many files in one batch, and a file that was not
+     * gathered is read on its first use. A file that does not exist has no time.
+     *
+     * The times are not refreshed, so a round must not outlive the jobs whose outputs it checks.
+     */
+    struct file_times
+    {
+      std::unordered_map<std::filesystem::path::string_type, std::optional<std::filesystem::file_time_type>> times{};
+      std::shared_mutex mutex{};
+
+      void gather(const std::vector<std::filesystem::path> &paths)
+      {
+        const std::scoped_lock<std::shared_mutex> lock(mutex);
+        path_set added{};
+        for (const auto &path : paths)
+          if (!times.contains(path.lexically_normal().make_preferred().native())) added.insert(path);
+        const auto added_times{file_write_times(added.paths)};
+        for (std::size_t index{}; index < added.paths.size(); ++index)
+          times.emplace(added.paths.at(index).lexically_normal().make_preferred().native(), added_times.at(index));
+      }
+      std::optional<std::filesystem::file_time_type> at(const std::filesystem::path &path)
+      {
+        auto normal{path.lexically_normal().make_preferred()};
+        {
+          const std::shared_lock<std::shared_mutex> lock(mutex);
+          if (const auto found{times.find(normal.native())}; found != times.end()) return found->second;
+        }
+        std::error_code error{};
+        std::optional<std::filesystem::file_time_type> time{std::filesystem::last_write_time(normal, error)};
+        if (error) time.reset();
+        record_inputs({normal});
+        const std::scoped_lock<std::shared_mutex> lock(mutex);
+        times.try_emplace(normal.native(), time);
+        return time;
+      }
     };
-    template <typename type, typename... vectors>
-    concept same_vectors = (std::same_as<std::remove_cvref_t<vectors>, std::vector<type>> && ...);
-  }
 
-  /**
-   * Runs every time csb is executed, before whatever main action is specified on the command line.
-   *
-   * This function should be used to set up the following variables:
-   * | `target_name`: The name of the target.
-   * | `target_artifact`: The artifact type of the target (executable, library, etc.).
-   * | `target_linkage`: The linkage type of the target (static or dynamic).
+    /**
+     * A file next to a target that its new content is written to before being renamed over the target. The same target
+     * may be written at once from several threads or processes, so every call names a different file.
+     */
+    inline std::filesystem::path temporary_file(const std::filesystem::path &file)
+    {
+      static std::atomic<std::uint64_t> count{};
+      auto temporary{file};
+      temporary += std::format(".{}.{}.tmp", std::chrono::steady_clock::now().time_since_epoch().count(), count++);
+      return temporary;
+    }
+
+    // Checks whether two files hold the same bytes, comparing their sizes before their content.
+    inline bool same_files(const std::filesystem::path &first, const std::filesystem::path &second)
+    {
+      std::error_code error{};
+      const auto first_size{std::filesystem::file_size(first, error)};
+      if (error) return false;
+      const auto second_size{std::filesystem::file_size(second, error)};
+      if (error || first_size != second_size) return false;
+      return std::ranges::equal(mapped_file{first}, mapped_file{second});
+    }
+
+    /**
+     * Copies a file by way of a temporary file and a rename, leaving the destination untouched when it already holds
+     * the same bytes so that it keeps its modification time. The copy shares or copies blocks in the kernel where the
+     * platform supports it and falls back to the standard library otherwise. Returns whether the file was copied.
+     */
+    inline bool copy_file(const std::filesystem::path &source, const std::filesystem::path &destination)
+    {
+      if (same_files(source, destination)) return false;
+      const auto temporary{temporary_file(destination)};
+      try
+      {
+        if (!clone_file(source, temporary))
+          std::filesystem::copy_file(source, temporary, std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::rename(temporary, destination);
+      }
+      catch (...)
+      {
+        std::error_code error{};
+        std::filesystem::remove(temporary, error);
+        throw;
+      }
+      return true;
+    }
+
+    // Adds the files to copy for a file or directory to a list, creating the directories they go in.
+    inline void plan_copy(const std::filesystem::path &source, const std::filesystem::path &destination,
+                          std::vector<std::pair<std::filesystem::path, std::filesystem::path>> &copies)
+    {
+      if (!std::filesystem::is_directory(source))
+      {
+        copies.emplace_back(source, destination);
+        return;
+      }
+      std::filesystem::create_directories(destination);
+      for (const auto &entry : std::filesystem::recursive_directory_iterator(
+             source, std::filesystem::directory_options::follow_directory_symlink))
+      {
+        const auto target{destination / entry.path().lexically_relative(source)};
+        if (entry.is_directory())
+          std::filesystem::create_directories(target);
+        else
+          copies.emplace_back(entry.path(), target);
+      }
+    }
+
+    /**
+     * Copies many files at the same time, rethrowing the first failure once every copy has finished. When several
+     * copies share a destination only the last one is made, as it would have won had they run one after another.
+     */
+    inline void copy_files(const std::vector<std::pair<std::filesystem::path, std::filesystem::path>> &planned)
+    {
+      std::unordered_map<std::filesystem::path, std::size_t> last_copies{};
+      for (std::size_t index{}; index < planned.size(); ++index) last_copies[planned[index].second] = index;
+      std::vector<std::pair<std::filesystem::path, std::filesystem::path>> copies{};
+      copies.reserve(last_copies.size());
+      for (std::size_t index{}; index < planned.size(); ++index)
+        if (last_copies.at(planned[index].second) == index) copies.push_back(planned[index]);
+
+      std::vector<std::exception_ptr> errors(copies.size());
+      std::transform(std::execution::par, copies.begin(), copies.end(), errors.begin(),
+                     [](const std::pair<std::filesystem::path, std::filesystem::path> &copy) -> std::exception_ptr
+                     {
+                       try
+                       {
+                         utility::copy_file(copy.first, copy.second);
+                         return nullptr;
+                       }
+                       catch (...)
+                       {
+                         return std::current_exception();
+                       }
+                     });
+      for (const auto &error : errors)
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Lists the regular files and subdirectories of a directory, the latter marked true, as a recursive directory
+    // iterator would visit them.
+    inline std::vector<std::pair<std::string, bool>> list_directory(const std::filesystem::path &directory)
+    {
+      if (auto listing{directory_listing(directory)}) return std::move(*listing);
+      std::vector<std::pair<std::string, bool>> entries{};
+      for (const auto &entry : std::filesystem::directory_iterator(directory))
+      {
+        const bool is_directory{entry.is_directory() && !entry.is_symlink()};
+        if (is_directory || entry.is_regular_file())
+          entries.emplace_back(entry.path().filename().string(), is_directory);
+      }
+      return entries;
+    }
+
+    /**
+     * Listings of directories that globs have walked, kept in "build/glob.cache" between runs along with each
+     * directory's modification time. Adding, removing or renaming an entry changes the time of the directory holding
+     * it, so a listing whose time still matches is used as is and only the directories whose times moved are read
+     * again. A directory modified within the last two seconds is read again next time, as a change made in the same
+     * tick as the listing would not move its time.
+     *
+     * Each listing holds the names of regular files, including links to them, and of subdirectories that are not
+     * links, in the order the directory was read; this is what a recursive directory iterator would visit.
+     */
+    struct directory_snapshots
+    {
+      struct listing
+      {
+        std::int64_t time{};
+        std::vector<std::pair<std::string, bool>> entries{};
+      };
+
+      std::filesystem::path file{std::filesystem::path{"build"} / "glob.cache"};
+      std::unordered_map<std::string, listing> listings{};
+      bool loaded{};
+      bool changed{};
+      std::mutex mutex{};
+
+      void load()
+      {
+        loaded = true;
+        std::ifstream input(file);
+        std::string line{};
+        if (!std::getline(input, line) || line != "csb glob cache 1") return;
+        listing *current{};
+        while (std::getline(input, line))
+        {
+          const auto value{line.size() < 2 ? std::string{} : line.substr(2)};
+          const auto space{value.find(' ')};
+          std::int64_t time{};
+          if (line.starts_with("> ") && space != std::string::npos &&
+              std::from_chars(value.data(), value.data() + space, time).ptr == value.data() + space)
+          {
+            current = &listings[value.substr(space + 1)];
+            current->time = time;
+          }
+          else if (current && (line.starts_with("f ") || line.starts_with("d ")))
+            current->entries.emplace_back(value, line.front() == 'd');
+          else
+          {
+            listings.clear();
+            return;
+          }
+        }
+      }
+
+      void save()
+      {
+        if (!changed || !std::filesystem::exists(file.parent_path())) return;
+        changed = false;
+        const auto temporary{temporary_file(file)};
+        bool written{};
+        {
+          std::ofstream output(temporary, std::ios::trunc);
+          output << "csb glob cache 1\n";
+          for (const auto &[directory, item] : listings)
+          {
+            output << "> " << item.time << ' ' << directory << '\n';
+            for (const auto &[name, is_directory] : item.entries)
+              output << (is_directory ? "d " : "f ") << name << '\n';
+          }
+          written = static_cast<bool>(output.flush());
+        }
+        std::error_code error{};
+        if (written) std::filesystem::rename(temporary, file, error);
+        if (!written || error) std::filesystem::remove(temporary, error);
+      }
+
+      const listing &list(const std::filesystem::path &directory)
+      {
+        if (!loaded) load();
+        const auto time{std::filesystem::last_write_time(directory)};
+        const auto key{directory.string()};
+        auto &item{listings[key]};
+        if (item.time == time.time_since_epoch().count() && item.time != 0) return item;
+
+        const auto previous{std::exchange(item.entries, list_directory(directory))};
+        const bool storable{std::filesystem::file_time_type::clock::now() - time > std::chrono::seconds{2} &&
+                            std::ranges::none_of(item.entries, [](const auto &entry)
+                                                 { return entry.first.find('\n') != std::string::npos; })};
+        item.time = storable ? time.time_since_epoch().count() : 0;
+        changed = true;
+        for (const auto &[name, is_directory] : previous)
+          if (is_directory && std::ranges::find(item.entries, std::pair{name, true}) == item.entries.end())
+            std::erase_if(listings,
+                          [removed{(directory / name).string()}, prefix{(directory / name / "").string()}](
+                            const auto &other) { return other.first == removed || other.first.starts_with(prefix); });
+        return listings.at(key);
+      }
+
+      // Appends the regular files in a directory, and in its subdirectories when recursing, to a list.
+      void collect(const std::filesystem::path &directory, const bool recursive,
+                   std::vector<std::filesystem::path> &files)
+      {
+        const auto entries{list(directory).entries};
+        for (const auto &[name, is_directory] : entries)
+          if (!is_directory)
+            files.push_back(directory / name);
+          else if (recursive)
+            collect(directory / name, recursive, files);
+      }
+    };
+    inline directory_snapshots glob_snapshots{};
+
+    inline std::string big_section_divider()
+    {
+      static const std::string divider = std::string(static_cast<size_t>(terminal_width()), '=');
+      return divider;
+    }
+    inline std::string small_section_divider()
+    {
+      static const std::string divider = std::string(static_cast<size_t>(terminal_width()), '-');
+      return divider;
+    }
+
+    template <typename container>
+    concept iterable = requires(container &type) {
+      std::begin(type);
+      std::end(type);
+    };
+    template <typename container>
+    concept iterable_string = requires(container &type) {
+      std::begin(type);
+      std::end(type);
+      requires std::same_as<std::remove_cvref_t<decltype(*std::begin(type))>, std::string> ||
+                 requires(decltype(*std::begin(type)) elem) {
+                   { elem.string() } -> std::convertible_to<std::string>;
+                 };
+    };
+    template <typename container>
+    concept iterable_path_dependency = requires(container &type) {
+      std::end(type);
+      std::begin(type);
+      requires std::same_as<std::remove_cvref_t<decltype(*std::begin(type))>, std::filesystem::path> ||
+                 std::same_as<std::remove_cvref_t<decltype(*std::begin(type))>,
+                              std::pair<const std::filesystem::path, std::vector<std::filesystem::path>>>;
+    };
+    template <typename tuple_type>
+    concept tuple = requires { typename std::tuple_size<tuple_type>::type; };
+    template <typename type>
+    concept serializable =
+      std::same_as<type, std::string> || std::same_as<type, std::vector<std::string>> ||
+      std::same_as<type, std::vector<std::byte>> || std::same_as<type, mapped_file> || std::same_as<type, csp::pack> ||
+      std::same_as<type, nlohmann::json>;
+    template <typename mod, typename data_type>
+    concept modifier = requires(mod modify, const data_type &value) {
+      { modify(value) } -> std::convertible_to<data_type>;
+    };
+    template <typename type, typename... vectors>
+    concept same_vectors = (std::same_as<std::remove_cvref_t<vectors>, std::vector<type>> && ...);
+  }
+
+  /**
+   * Runs every time csb is executed, before whatever main action is specified on the command line.
+   *
+   * This function should be used to set up the following variables:
+   * | `target_name`: The name of the target.
+   * | `target_artifact`: The artifact type of the target (executable, library, etc.).
+   * | `target_linkage`: The linkage type of the target (static or dynamic).
    * | `target_subsystem`: The target subsystem of the target (console, windows, etc.) - only affects Windows.
-   * | `target_configuration`: The build configuration to use (Debug, Release, etc.).
+   * | `target_configuration`: The build configuration to use (DEBUG, RELEASE, PROFILE, RELWITHDEBINFO or custom).
+   * | `configurations`: A list of configurations selectable by name, custom configurations should be added here.
    * | `cxx_standard`: The C++ standard to use (Availability starting at 11 up to the latest STABLE standard).
    * | `warning_level`: The warning level to use (0-4).
+   * | `batch_size`: How many small source files a single compiler invocation may compile (Linux only).
+   * | `batch_file_size`: The size in bytes up to which a source file counts as small enough to be batched.
+   * | `precompiled_header_store`: A directory shared between projects for reusing compiled precompiled headers.
+   * | `partial_links`: Whether to group objects by source directory into relocatable partial links (Linux only).
+   * | `thin_archives`: Whether static libraries only reference their objects, for in-tree consumers (Linux only).
    * | `source_files`: A list of the target's source files.
    * | `include_files`: A list of the target's include files.
    * | `precompiled_headers`: A list of the target's precompiled header files.
@@ -28478,6 +29520,9 @@ namespace csb
    * | `library_directories`: A list of the target's library directories.
    * | `libraries`: A list of libraries to link against.
    * | `definitions`: A list of preprocessor definitions to apply to every source file.
+   * | `precompiled_header_sources`: Precompiled headers force included into listed sources (all sources of the
+   *   header's language if empty) instead of scanning sources for them. Headers must also be in `precompiled_headers`.
+   * | `object_files`: A list of object files that are linked into the target as they are.
    *
    * Useful variables for all functions include:
    * | `arguments`: A list of command line arguments not recognized by csb.
@@ -28488,6 +29533,7 @@ namespace csb
    * Useful functions for all functions include:
    * | `path`: Returns a preferred version of a path given to it.
    * | `choose_files`: Gets a list of files from a specified directory with optional filtering and recursion.
+   * | `glob_files`: Gets a sorted list of files matching glob patterns, honouring ".gitignore" and ".csbignore".
    * | `contains`: Checks if a container contains a specified value.
    * | `unpack`: Converts a list of paths to a space-separated string.
    * | `combine`: Combines multiple lists into one, removing duplicates and preserving order.
@@ -28511,6 +29557,8 @@ namespace csb
    * | `read_file`: Reads the contents of a specified file as a specified format.
    * | `write_file`: Writes data to a specified file in a specified format.
    * | `modify_file`: Modifies the content of a specified file using a specified modifier function.
+   * | `find_configuration`: Returns the configuration with a specified name from `configurations`.
+   * | `configuration_directory`: Returns the build directory of the active configuration.
    *
    * See also: `clean` | `build` | `run`
    */
@@ -28533,6 +29581,8 @@ namespace csb
    * Common uses for this function are to call the following functions:
    * | `compile`: Compiles all source files into object files and selected headers into precompiled headers.
    * | `link`: Links all object files into the target artifact.
+   * | `compile`/`link` with a list of `target`s: Builds multiple targets together, sharing identical objects and
+   *   linking in dependency order.
    * | `generate_compile_commands`: Generates a compile_commands.json file for LSP support.
    * | `generate_clangd`: Generates a .clangd file for clangd configuration.
    * | `generate_clang_tidy`: Generates a .clang-tidy file based on a configuration passed to it.
@@ -28544,6 +29594,7 @@ namespace csb
    * | `archive_install`: Installs all specified archives to a specified directory.
    * | `file_install`: Installs all specified files to a specified directory.
    * | `embed`: Provides an interface for embedding data into a compilation unit for use in the target.
+   * | `embed_object`: Embeds resources straight into an object file that is linked into the target.
    * | `task_run`: Runs a specified task with a custom dependency language.
    * | `multi_task_run`: Runs multiple specified tasks with a custom dependency language.
    * | `live_task_run`: Runs a specified task with a custom dependnecy language and streams it as it runs.
@@ -28642,12 +29693,50 @@ namespace csb
     choice.flush();
   }
 
+  namespace utility
+  {
+    // The "0x" prefixed hexadecimal representation of every byte value, for formatting bytes without streams.
+    inline constexpr auto hex_bytes{[]
+                                    {
+                                      constexpr std::string_view digits{"0123456789abcdef"};
+                                      std::array<std::array<char, 4>, 256> table{};
+                                      for (std::size_t value{}; value < table.size(); ++value)
+                                        table[value] = {'0', 'x', digits[value >> 4], digits[value & 15]};
+                                      return table;
+                                    }()};
+
+    /**
+     * Formats bytes as a comma-separated list of hexadecimal values with sixteen to a row, handing each finished row
+     * to a writer so that the whole list never has to be held in memory.
+     */
+    inline void write_hex_bytes(const std::span<const std::byte> bytes,
+                                const std::function<void(std::string_view)> &write)
+    {
+      constexpr std::size_t row_size{16};
+      std::array<char, (row_size * 6) + 4> row{};
+      for (std::size_t start{}; start < bytes.size(); start += row_size)
+      {
+        char *cursor{row.data()};
+        for (std::size_t index{start}; index < std::min(start + row_size, bytes.size()); ++index)
+        {
+          cursor = std::ranges::copy(hex_bytes[std::to_integer<std::size_t>(bytes[index])], cursor).out;
+          if (index == bytes.size() - 1) break;
+          *cursor++ = ',';
+          if ((index + 1) % row_size == 0)
+            cursor = std::ranges::copy(std::string_view{"\n    "}, cursor).out;
+          else
+            *cursor++ = ' ';
+        }
+        write({row.data(), static_cast<std::size_t>(cursor - row.data())});
+      }
+    }
+  }
+
   // Converts a byte to its hexadecimal string representation.
   inline std::string byte_to_hex(std::byte character)
   {
-    std::stringstream stream{};
-    stream << "0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(character);
-    return stream.str();
+    const auto &hex{utility::hex_bytes[std::to_integer<std::size_t>(character)]};
+    return {hex.begin(), hex.end()};
   };
 
   // Converts a nlohmann::json object to a YAML string.
@@ -28833,37 +29922,50 @@ namespace csb
   inline void touch(std::initializer_list<std::filesystem::path> paths)
   { touch(std::vector<std::filesystem::path>{paths}); }
 
-  // Copies the specified files to the destination.
-  inline void copy(const std::filesystem::path &source, const std::filesystem::path &destination)
-  {
-    if (!std::filesystem::exists(source)) throw std::runtime_error("Source file does not exist: " + source.string());
-    if (!std::filesystem::exists(destination)) std::filesystem::create_directories(destination);
-    std::filesystem::copy(source, destination / source.filename(),
-                          std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
-  }
-  // Copies the specified files to the destination.
+  // Copies the specified files to the destination, in parallel and skipping files that are already identical.
   inline void copy(const std::vector<std::filesystem::path> &sources, const std::filesystem::path &destination)
   {
-    for (const auto &source : sources) csb::copy(source, destination);
+    std::vector<std::pair<std::filesystem::path, std::filesystem::path>> copies{};
+    for (const auto &source : sources)
+    {
+      if (!std::filesystem::exists(source)) throw std::runtime_error("Source file does not exist: " + source.string());
+      if (!std::filesystem::exists(destination)) std::filesystem::create_directories(destination);
+      utility::plan_copy(source, destination / source.filename(), copies);
+    }
+    utility::copy_files(copies);
   }
+  // Copies the specified files to the destination, in parallel and skipping files that are already identical.
+  inline void copy(const std::filesystem::path &source, const std::filesystem::path &destination)
+  { copy(std::vector<std::filesystem::path>{source}, destination); }
   // Copies the specified files to the destination.
   inline void copy(std::initializer_list<std::filesystem::path> sources, const std::filesystem::path &destination)
   { copy(std::vector<std::filesystem::path>{sources}, destination); }
 
-  // Moves the specified files to the destination.
-  inline void move(const std::filesystem::path &source, const std::filesystem::path &destination)
-  {
-    if (!std::filesystem::exists(source)) throw std::runtime_error("Source file does not exist: " + source.string());
-    if (!std::filesystem::exists(destination)) std::filesystem::create_directories(destination);
-    std::filesystem::copy(source, destination / source.filename(),
-                          std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
-    std::filesystem::remove_all(source);
-  }
-  // Moves the specified files to the destination.
+  // Moves the specified files to the destination, renaming them where nothing is in the way and copying otherwise.
   inline void move(const std::vector<std::filesystem::path> &sources, const std::filesystem::path &destination)
   {
-    for (const auto &source : sources) move(source, destination);
+    std::vector<std::pair<std::filesystem::path, std::filesystem::path>> copies{};
+    std::vector<std::filesystem::path> copied{};
+    for (const auto &source : sources)
+    {
+      if (!std::filesystem::exists(source)) throw std::runtime_error("Source file does not exist: " + source.string());
+      if (!std::filesystem::exists(destination)) std::filesystem::create_directories(destination);
+      const auto target{destination / source.filename()};
+      std::error_code error{};
+      if (!std::filesystem::exists(target))
+      {
+        std::filesystem::rename(source, target, error);
+        if (!error) continue;
+      }
+      utility::plan_copy(source, target, copies);
+      copied.push_back(source);
+    }
+    utility::copy_files(copies);
+    for (const auto &source : copied) std::filesystem::remove_all(source);
   }
+  // Moves the specified files to the destination, renaming them where nothing is in the way and copying otherwise.
+  inline void move(const std::filesystem::path &source, const std::filesystem::path &destination)
+  { move(std::vector<std::filesystem::path>{source}, destination); }
   // Moves the specified files to the destination.
   inline void move(std::initializer_list<std::filesystem::path> sources, const std::filesystem::path &destination)
   { move(std::vector<std::filesystem::path>{sources}, destination); }
@@ -28900,6 +30002,8 @@ namespace csb
    * | `accept`: An optional function that takes a file path and returns true if the file should be included.
    * | `overrides`: An optional list of files to always include in the result.
    * | `recursive`: A true by default boolean indicating whether the directory search is recursive.
+   *
+   * Directory listings are cached between runs and only directories whose modification times changed are read again.
    */
   inline std::vector<std::filesystem::path>
   choose_files(const std::vector<std::filesystem::path> &directories,
@@ -28907,37 +30011,288 @@ namespace csb
                const std::vector<std::filesystem::path> &overrides = {}, bool recursive = true)
   {
     std::vector<std::filesystem::path> files{};
-    auto process_directory{[&](const auto &iterator)
-                           {
-                             for (const auto &entry : iterator)
-                               if (entry.is_regular_file())
-                               {
-                                 if (accept && !accept(entry.path())) continue;
-                                 files.push_back(entry.path());
-                               }
-                           }};
-    if (directories.empty())
-      recursive ? process_directory(std::filesystem::recursive_directory_iterator(std::filesystem::current_path()))
-                : process_directory(std::filesystem::directory_iterator(std::filesystem::current_path()));
-    for (const auto &directory : directories)
     {
-      if (!std::filesystem::exists(directory) || !std::filesystem::is_directory(directory))
-        throw std::runtime_error("Directory does not exist: " + directory.string());
-      recursive ? process_directory(std::filesystem::recursive_directory_iterator(directory))
-                : process_directory(std::filesystem::directory_iterator(directory));
+      auto &snapshots{utility::glob_snapshots};
+      const std::scoped_lock<std::mutex> lock(snapshots.mutex);
+      if (directories.empty()) snapshots.collect(std::filesystem::current_path(), recursive, files);
+      for (const auto &directory : directories)
+      {
+        if (!std::filesystem::exists(directory) || !std::filesystem::is_directory(directory))
+          throw std::runtime_error("Directory does not exist: " + directory.string());
+        snapshots.collect(directory, recursive, files);
+      }
+      snapshots.save();
     }
+    if (accept) std::erase_if(files, [&accept](const std::filesystem::path &file) { return !accept(file); });
+    utility::path_set chosen{};
+    for (const auto &file : files) chosen.insert(file);
     for (const auto &override : overrides)
+      if (chosen.insert(override)) files.push_back(override);
+    for (auto &file : files) file.make_preferred();
+    return files;
+  }
+
+  namespace utility
+  {
+    // Splits a path or pattern into its segments, dropping empty and "." segments.
+    inline std::vector<std::string> glob_segments(const std::string_view text)
+    {
+      std::vector<std::string> segments{};
+      std::size_t start{};
+      while (start <= text.size())
+      {
+        auto end{text.find('/', start)};
+        if (end == std::string_view::npos) end = text.size();
+        if (const auto segment{text.substr(start, end - start)}; !segment.empty() && segment != ".")
+          segments.emplace_back(segment);
+        start = end + 1;
+      }
+      return segments;
+    }
+
+    // Matches one path segment against one pattern segment, where `*` matches any run of characters, `?` matches any
+    // one character and `[...]` matches one character from a set, negated by a leading `!` or `^`.
+    inline bool glob_segment_match(const std::string_view pattern, const std::string_view text)
     {
-      bool found{};
-      for (auto &file : files)
-        if (file == override)
+      std::size_t pattern_index{};
+      std::size_t text_index{};
+      std::size_t star{std::string_view::npos};
+      std::size_t star_text{};
+      while (text_index < text.size())
+      {
+        bool matched{};
+        std::size_t next{pattern_index + 1};
+        if (pattern_index < pattern.size() && pattern.at(pattern_index) == '*')
         {
-          found = true;
-          break;
+          star = pattern_index++;
+          star_text = text_index;
+          continue;
+        }
+        if (pattern_index < pattern.size() && pattern.at(pattern_index) == '[')
+        {
+          std::size_t index{pattern_index + 1};
+          const bool negated{index < pattern.size() && (pattern.at(index) == '!' || pattern.at(index) == '^')};
+          if (negated) ++index;
+          bool in_set{};
+          for (bool first{true}; index < pattern.size() && (first || pattern.at(index) != ']'); first = false)
+          {
+            const auto low{pattern.at(index)};
+            auto high{low};
+            if (index + 2 < pattern.size() && pattern.at(index + 1) == '-' && pattern.at(index + 2) != ']')
+            {
+              high = pattern.at(index + 2);
+              index += 2;
+            }
+            if (low <= text.at(text_index) && text.at(text_index) <= high) in_set = true;
+            ++index;
+          }
+          if (index < pattern.size())
+          {
+            matched = in_set != negated;
+            next = index + 1;
+          }
+          else
+            matched = pattern.at(pattern_index) == text.at(text_index);
+        }
+        else if (pattern_index < pattern.size())
+          matched = pattern.at(pattern_index) == '?' || pattern.at(pattern_index) == text.at(text_index);
+        if (matched)
+        {
+          pattern_index = next;
+          ++text_index;
+        }
+        else if (star != std::string_view::npos)
+        {
+          pattern_index = star + 1;
+          text_index = ++star_text;
         }
-      if (!found) files.push_back(override);
+        else
+          return false;
+      }
+      while (pattern_index < pattern.size() && pattern.at(pattern_index) == '*') ++pattern_index;
+      return pattern_index == pattern.size();
     }
-    for (auto &file : files) file.make_preferred();
+
+    /**
+     * Matches path segments against pattern segments, where a `**` segment matches any number of segments. When
+     * `below` is set, the path is a directory and the result is whether a path inside it could match, which is what
+     * lets a walk skip directories that nothing can match.
+     */
+    inline bool glob_match(const std::span<const std::string> pattern, const std::span<const std::string> text,
+                           const bool below = false)
+    {
+      if (pattern.empty()) return !below && text.empty();
+      if (pattern.front() == "**")
+        return glob_match(pattern.subspan(1), text, below) ||
+               (!text.empty() && glob_match(pattern, text.subspan(1), below));
+      if (text.empty()) return below;
+      return glob_segment_match(pattern.front(), text.front()) &&
+             glob_match(pattern.subspan(1), text.subspan(1), below);
+    }
+
+    /**
+     * The rules of the ".gitignore" and ".csbignore" files in one directory, linked to those of its parent directory.
+     * Rules follow gitignore: a leading `!` re-includes, a trailing `/` only matches directories, and a pattern with no
+     * other `/` matches at any depth below the directory. Deeper rules and later rules take precedence.
+     */
+    struct ignore_rules
+    {
+      struct rule
+      {
+        std::vector<std::string> segments{};
+        bool negated{};
+        bool directory_only{};
+      };
+
+      std::size_t depth{};
+      std::vector<rule> rules{};
+      std::shared_ptr<const ignore_rules> parent{};
+
+      void read(const std::filesystem::path &file)
+      {
+        std::ifstream input(file);
+        std::string line{};
+        while (std::getline(input, line))
+        {
+          while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+          if (line.empty() || line.front() == '#') continue;
+          rule item{};
+          if (line.front() == '!')
+          {
+            item.negated = true;
+            line.erase(0, 1);
+          }
+          else if (line.starts_with("\\!") || line.starts_with("\\#"))
+            line.erase(0, 1);
+          if (line.ends_with('/'))
+          {
+            item.directory_only = true;
+            line.pop_back();
+          }
+          if (line.empty()) continue;
+          if (line.find('/') == std::string::npos) line.insert(0, "**/");
+          item.segments = glob_segments(line);
+          rules.push_back(std::move(item));
+        }
+      }
+
+      static bool ignored(const ignore_rules *rules, const std::vector<std::string> &path, const bool is_directory)
+      {
+        for (; rules; rules = rules->parent.get())
+          for (const auto &item : std::ranges::reverse_view(rules->rules))
+            if ((is_directory || !item.directory_only) &&
+                glob_match(item.segments, std::span{path}.subspan(std::min(rules->depth, path.size()))))
+              return !item.negated;
+        return false;
+      }
+    };
+  }
+
+  /**
+   * Gets a sorted list of files matching glob patterns, walking directories in parallel and skipping whole directories
+   * that no pattern can match, that an exclude matches or that ignore files exclude.
+   *
+   * This functions parameters behave as follows:
+   * | `patterns`: Patterns relative to the current working directory, using `/` between segments. `*` and `?` match
+   *   within a segment, `[...]` matches a set of characters and a `**` segment matches any number of directories, so
+   *   the segments "source", `**` and "*.cpp" match every ".cpp" file under "source".
+   * | `excludes`: Optional patterns for files and directories to leave out, such as everything under source/generated.
+   *
+   * The ".gitignore" and ".csbignore" files of every directory walked are honoured, and ".git" is never walked.
+   *
+   * See also: `choose_files`.
+   */
+  inline std::vector<std::filesystem::path> glob_files(const std::vector<std::string> &patterns,
+                                                       const std::vector<std::string> &excludes = {})
+  {
+    auto compile{[](const std::vector<std::string> &list)
+                 {
+                   std::vector<std::vector<std::string>> compiled{};
+                   for (const auto &pattern : list)
+                   {
+                     auto segments{utility::glob_segments(pattern)};
+                     if (pattern.starts_with('/') || contains(segments, std::string{".."}))
+                       throw std::runtime_error("Glob patterns must be inside the current directory: " + pattern);
+                     compiled.push_back(std::move(segments));
+                   }
+                   return compiled;
+                 }};
+    const auto includes{compile(patterns)};
+    const auto exclusions{compile(excludes)};
+
+    struct directory
+    {
+      std::string path{};
+      std::size_t depth{};
+      std::shared_ptr<const utility::ignore_rules> ignores{};
+    };
+    struct listing
+    {
+      std::vector<std::string> files{};
+      std::vector<directory> directories{};
+      std::exception_ptr error{};
+    };
+    auto walk{[&](const directory &current)
+              {
+                listing result{};
+                try
+                {
+                  const auto entries{utility::list_directory(current.path.empty() ? "." : current.path)};
+                  auto ignores{current.ignores};
+                  for (const auto *name : {".gitignore", ".csbignore"})
+                    if (contains(entries, std::pair<std::string, bool>{name, false}))
+                    {
+                      auto rules{std::make_shared<utility::ignore_rules>()};
+                      rules->depth = current.depth;
+                      rules->parent = ignores;
+                      rules->read(std::filesystem::path{current.path.empty() ? "." : current.path} / name);
+                      ignores = std::move(rules);
+                    }
+                  for (const auto &[name, is_directory] : entries)
+                  {
+                    if (name == ".git") continue;
+                    auto path{current.path.empty() ? name : current.path + '/' + name};
+                    const auto segments{utility::glob_segments(path)};
+                    if (utility::ignore_rules::ignored(ignores.get(), segments, is_directory) ||
+                        std::ranges::any_of(exclusions, [&](const auto &exclude)
+                                            { return utility::glob_match(exclude, segments); }))
+                      continue;
+                    if (std::ranges::none_of(includes, [&](const auto &include)
+                                             { return utility::glob_match(include, segments, is_directory); }))
+                      continue;
+                    if (is_directory)
+                      result.directories.push_back({std::move(path), current.depth + 1, ignores});
+                    else
+                      result.files.push_back(std::move(path));
+                  }
+                }
+                catch (...)
+                {
+                  result.error = std::current_exception();
+                }
+                return result;
+              }};
+
+    std::vector<std::string> found{};
+    std::vector<directory> frontier{{}};
+    while (!frontier.empty())
+    {
+      std::vector<listing> listings(frontier.size());
+      std::transform(std::execution::par, frontier.begin(), frontier.end(), listings.begin(), walk);
+      frontier.clear();
+      for (auto &item : listings)
+      {
+        if (item.error) std::rethrow_exception(item.error);
+        found.insert(found.end(), std::make_move_iterator(item.files.begin()),
+                     std::make_move_iterator(item.files.end()));
+        frontier.insert(frontier.end(), std::make_move_iterator(item.directories.begin()),
+                        std::make_move_iterator(item.directories.end()));
+      }
+    }
+    std::ranges::sort(found);
+    std::vector<std::filesystem::path> files{};
+    files.reserve(found.size());
+    for (const auto &file : found) files.push_back(std::filesystem::path{file}.make_preferred());
     return files;
   }
 
@@ -28948,6 +30303,7 @@ namespace csb
    * | `std::string`: Reads the file into a single string.
    * | `std::vector<std::string>`: Reads the file into a list of strings, one per line.
    * | `std::vector<std::byte>`: Reads the file into a byte array.
+   * | `mapped_file`: Maps the file into a read only view of its bytes without copying them.
    * | `csp::pack`: Reading csp data is not supported.
    * | `nlohmann::json`: Reads the file as a JSON object.
    *
@@ -28957,7 +30313,9 @@ namespace csb
   {
     if (!std::filesystem::exists(file)) throw std::runtime_error("File does not exist: " + file.string());
 
-    if constexpr (std::same_as<type, std::vector<std::byte>>)
+    if constexpr (std::same_as<type, mapped_file>)
+      return mapped_file{file};
+    else if constexpr (std::same_as<type, std::vector<std::byte>>)
     {
       type container{};
       std::ifstream input_file(file, std::ios::binary);
@@ -28990,47 +30348,220 @@ namespace csb
     return container;
   }
 
-  /**
-   * Writes data to a specified file in a specified format.
-   *
-   * This function supports the following types:
-   * | `std::string`: Writes the string to the file.
-   * | `std::vector<std::string>`: Writes each string in the list to the file, one per line.
-   * | `std::vector<std::byte>`: Writes the byte array to the file.
-   * | `csp::pack`: Writes the csp data to the file.
-   * | `nlohmann::json`: Writes the JSON object to the file.
-   *
-   * See also: `read_file`, `modify_file`.
-   */
-  template <utility::serializable type> void write_file(const std::filesystem::path &file, const type &container)
+  namespace utility
   {
-    if (file.has_parent_path()) std::filesystem::create_directories(file.parent_path());
-
-    if constexpr (std::same_as<type, std::vector<std::byte>>)
-    {
-      std::ofstream output_file(file, std::ios::binary);
-      if (!output_file.is_open()) throw std::runtime_error("Failed to open file: " + file.string());
-      if (!output_file.write(reinterpret_cast<const char *>(container.data()),
-                             static_cast<std::streamsize>(container.size())))
-        throw std::runtime_error("Failed to write file: " + file.string());
-      output_file.close();
-      return;
+    // Converts data into the bytes that `write_file` writes for it, with text written with the platform's line endings.
+    template <serializable type> std::string serialize(const type &container)
+    {
+      std::string content{};
+      if constexpr (std::same_as<type, std::vector<std::byte>> || std::same_as<type, mapped_file>)
+        return {reinterpret_cast<const char *>(container.data()), container.size()};
+      else if constexpr (std::same_as<type, std::string>)
+        content = container;
+      else if constexpr (std::same_as<type, std::vector<std::string>>)
+        for (const auto &line : container) content += line + '\n';
+      else if constexpr (std::same_as<type, nlohmann::json>)
+        content = container.dump(2);
+      if (PLATFORM != WINDOWS) return content;
+      std::string text{};
+      text.reserve(content.size() + content.size() / 32);
+      for (const auto character : content)
+      {
+        if (character == '\n') text += '\r';
+        text += character;
+      }
+      return text;
     }
-    else if constexpr (std::same_as<type, csp::pack>)
+
+    // Checks if a file holds exactly the given bytes, comparing sizes before reading anything.
+    inline bool same_content(const std::filesystem::path &file, const std::string_view content)
     {
-      csp::write(container, file);
-      return;
+      std::error_code error{};
+      if (std::filesystem::file_size(file, error) != content.size() || error) return false;
+      std::ifstream input(file, std::ios::binary);
+      std::array<char, 65536> buffer{};
+      for (std::size_t offset{}; offset < content.size();)
+      {
+        const auto length{std::min(buffer.size(), content.size() - offset)};
+        if (!input.read(buffer.data(), static_cast<std::streamsize>(length)) ||
+            std::string_view{buffer.data(), length} != content.substr(offset, length))
+          return false;
+        offset += length;
+      }
+      return true;
     }
 
-    std::ofstream output_file(file);
-    if (!output_file.is_open()) throw std::runtime_error("Failed to open file: " + file.string());
-    if constexpr (std::same_as<type, std::string>)
-      output_file << container;
-    else if constexpr (std::same_as<type, std::vector<std::string>>)
-      for (const auto &line : container) output_file << line << '\n';
-    else if constexpr (std::same_as<type, nlohmann::json>)
-      output_file << container.dump(2);
-    output_file.close();
+    // Writes bytes to a file by way of a temporary file and a rename, so the file is never left partially written.
+    inline void replace_file(const std::filesystem::path &file, const std::string_view content)
+    {
+      if (file.has_parent_path()) std::filesystem::create_directories(file.parent_path());
+      const auto temporary{temporary_file(file)};
+      {
+        std::ofstream output_file(temporary, std::ios::binary | std::ios::trunc);
+        if (!output_file.is_open()) throw std::runtime_error("Failed to open file: " + file.string());
+        if (!output_file.write(content.data(), static_cast<std::streamsize>(content.size())) || !output_file.flush())
+        {
+          output_file.close();
+          std::filesystem::remove(temporary);
+          throw std::runtime_error("Failed to write file: " + file.string());
+        }
+      }
+      std::filesystem::rename(temporary, file);
+    }
+
+    /**
+     * Streams text into a file through a large buffer and a temporary file, so that the content never has to be held
+     * in memory as a whole. Committing leaves the file untouched if it already holds the same content, like
+     * `update_file`; a stream that is never committed leaves no trace.
+     */
+    class streamed_file
+    {
+    public:
+      explicit streamed_file(const std::filesystem::path &target) : file{target}, temporary{temporary_file(target)}
+      {
+        if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path());
+        output.open(temporary, std::ios::trunc);
+        if (!output.is_open()) throw std::runtime_error("Failed to open file: " + target.string());
+        buffer.reserve(buffer_size);
+      }
+      ~streamed_file()
+      {
+        if (committed) return;
+        output.close();
+        std::error_code error{};
+        std::filesystem::remove(temporary, error);
+      }
+      streamed_file(const streamed_file &) = delete;
+      streamed_file &operator=(const streamed_file &) = delete;
+
+      void write(const std::string_view text)
+      {
+        if (buffer.size() + text.size() > buffer_size) flush();
+        if (text.size() >= buffer_size)
+          output.write(text.data(), static_cast<std::streamsize>(text.size()));
+        else
+          buffer += text;
+      }
+
+      // Moves the content into place unless it matches the file's current content. Returns whether it was moved.
+      bool commit()
+      {
+        flush();
+        output.close();
+        committed = true;
+        if (!output)
+        {
+          std::filesystem::remove(temporary);
+          throw std::runtime_error("Failed to write file: " + file.string());
+        }
+        if (same_files(temporary, file))
+        {
+          std::filesystem::remove(temporary);
+          return false;
+        }
+        std::filesystem::rename(temporary, file);
+        return true;
+      }
+
+    private:
+      static constexpr std::size_t buffer_size{1 << 20};
+
+      void flush()
+      {
+        output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+      }
+
+      std::filesystem::path file{};
+      std::filesystem::path temporary{};
+      std::ofstream output{};
+      std::string buffer{};
+      bool committed{};
+    };
+  }
+
+  /**
+   * Writes data to a specified file in a specified format. The data is written to a temporary file that then replaces
+   * the file, so an interrupted write never leaves a partial file behind.
+   *
+   * This function supports the following types:
+   * | `std::string`: Writes the string to the file.
+   * | `std::vector<std::string>`: Writes each string in the list to the file, one per line.
+   * | `std::vector<std::byte>`: Writes the byte array to the file.
+   * | `mapped_file`: Writes the viewed bytes to the file.
+   * | `csp::pack`: Writes the csp data to the file.
+   * | `nlohmann::json`: Writes the JSON object to the file.
+   *
+   * See also: `read_file`, `modify_file`, `update_file`.
+   */
+  template <utility::serializable type> void write_file(const std::filesystem::path &file, const type &container)
+  {
+    if constexpr (std::same_as<type, csp::pack>)
+    {
+      if (file.has_parent_path()) std::filesystem::create_directories(file.parent_path());
+      const auto temporary{utility::temporary_file(file)};
+      csp::write(container, temporary);
+      std::filesystem::rename(temporary, file);
+    }
+    else
+      utility::replace_file(file, utility::serialize(container));
+  }
+
+  /**
+   * Writes data to a specified file like `write_file`, but leaves the file untouched when it already holds the same
+   * data, so generated files keep their modification time and whatever depends on them is not rebuilt. Returns
+   * whether the file was written.
+   *
+   * Because an unchanged file keeps its old time, a task that checks it against newer inputs would run again on every
+   * build, so such tasks check a `utility::task_stamp` instead; use `write_file` for files that only serve as a record
+   * of when something last ran.
+   *
+   * See also: `write_file`.
+   */
+  template <utility::serializable type> bool update_file(const std::filesystem::path &file, const type &container)
+  {
+    if constexpr (std::same_as<type, csp::pack>)
+    {
+      if (file.has_parent_path()) std::filesystem::create_directories(file.parent_path());
+      const auto temporary{utility::temporary_file(file)};
+      csp::write(container, temporary);
+      const auto content{utility::serialize(read_file<std::vector<std::byte>>(temporary))};
+      if (utility::same_content(file, content))
+      {
+        std::filesystem::remove(temporary);
+        return false;
+      }
+      std::filesystem::rename(temporary, file);
+      return true;
+    }
+    else
+    {
+      const auto content{utility::serialize(container)};
+      if (utility::same_content(file, content)) return false;
+      utility::replace_file(file, content);
+      return true;
+    }
+  }
+
+  namespace utility
+  {
+    /**
+     * Returns the stamp file whose modification time records when the task writing the given outputs last ran. Tasks
+     * that write with `update_file` check their inputs against the stamp rather than the outputs, which keep their
+     * older time while nothing in them changes, and touch it after every run. The stamp is removed while an output is
+     * missing, so that the task runs again.
+     */
+    inline std::filesystem::path task_stamp(const std::vector<std::filesystem::path> &outputs)
+    {
+      std::string key{};
+      for (const auto &output : outputs) key += output.lexically_normal().generic_string() + "|";
+      const auto stamp{std::filesystem::path{"build"} / "stamp" /
+                       std::format("{:016x}", csp::signature(key.data(), key.size()))};
+      if (!std::ranges::all_of(outputs, [](const std::filesystem::path &output)
+                               { return std::filesystem::exists(output); }))
+        std::filesystem::remove(stamp);
+      return stamp;
+    }
   }
 
   /**
@@ -29043,6 +30574,7 @@ namespace csb
    * | `std::string`: Writes the string to the file.
    * | `std::vector<std::string>`: Writes each string in the list to the file, one per line.
    * | `std::vector<std::byte>`: Writes the byte array to the file.
+   * | `mapped_file`: Modifying mapped files is not supported.
    * | `csp::pack`: Modifying csp data is not supported.
    * | `nlohmann::json`: Writes the JSON object to the file.
    *
@@ -29052,6 +30584,7 @@ namespace csb
   void modify_file(const std::filesystem::path &file, const modifier &modify)
   {
     if constexpr (std::same_as<type, csp::pack>) throw std::runtime_error("Modifying csp data is not supported.");
+    if constexpr (std::same_as<type, mapped_file>) throw std::runtime_error("Modifying mapped files is not supported.");
 
     type container{read_file<type>(file)};
     container = modify(container);
@@ -29095,10 +30628,10 @@ enum task : std::uint8_t
   BUILD,
   RUN
 };
-enum configuration : std::uint8_t
+enum runtime : std::uint8_t
 {
-  RELEASE,
-  DEBUG
+  RELEASE_RUNTIME,
+  DEBUG_RUNTIME
 };
 enum subsystem : std::uint8_t
 {
@@ -29112,22 +30645,150 @@ enum subproject : std::uint8_t
   HEADER_LIBRARY
 };
 
+struct configuration
+{
+  // The name used to select the configuration and to pass it on to subprojects.
+  std::string name{};
+  // The subdirectory of "build" that the configuration's outputs are written to.
+  std::filesystem::path directory{};
+  // The runtime library to link against; the debug runtime also defines _DEBUG instead of NDEBUG.
+  runtime runtime_library{RELEASE_RUNTIME};
+  // Whether debug information is generated, adding /Zi or -g to compiles, /DEBUG to links and pdb outputs on Windows.
+  bool symbols{};
+  // Whether debug information is kept in .dwo files next to the objects instead of being linked (only affects Linux).
+  bool split_dwarf{};
+  // Whether the .dwo files are packaged into a .dwp next to the artifact in the background after linking.
+  bool package_dwarf{};
+  // Whether the linker writes a .gdb_index section, which needs a linker such as gold or lld set in link_flags.
+  bool gdb_index{};
+  // The compression of debug sections, such as "zlib" or "zstd" if the toolchain supports it, or empty for none.
+  std::string debug_compression{};
+  // Flags added to every compile command; debug information flags come from `symbols` instead.
+  std::vector<std::string> compile_flags{};
+  // Flags added to every link command, but not to static library archiving.
+  std::vector<std::string> link_flags{};
+  // Preprocessor definitions added to every source file on top of the runtime definition.
+  std::vector<std::string> definitions{};
+
+  bool operator==(const configuration &other) const = default;
+};
+inline const configuration RELEASE{
+  .name = "release",
+  .directory = "release",
+  .runtime_library = RELEASE_RUNTIME,
+  .symbols = false,
+  .compile_flags = PLATFORM == WINDOWS ? std::vector<std::string>{"/O2"} : std::vector<std::string>{"-O3"},
+};
+inline const configuration DEBUG{
+  .name = "debug",
+  .directory = "debug",
+  .runtime_library = DEBUG_RUNTIME,
+  .symbols = true,
+  .compile_flags = PLATFORM == WINDOWS ? std::vector<std::string>{"/Od", "/RTC1"} : std::vector<std::string>{"-Og"},
+};
+inline const configuration PROFILE{
+  .name = "profile",
+  .directory = "profile",
+  .runtime_library = RELEASE_RUNTIME,
+  .symbols = true,
+  .compile_flags = PLATFORM == WINDOWS ? std::vector<std::string>{"/O2", "/Oy-"}
+                                       : std::vector<std::string>{"-O2", "-fno-omit-frame-pointer"},
+  .link_flags = PLATFORM == WINDOWS ? std::vector<std::string>{} : std::vector<std::string>{"-fno-omit-frame-pointer"},
+};
+inline const configuration RELWITHDEBINFO{
+  .name = "relwithdebinfo",
+  .directory = "relwithdebinfo",
+  .runtime_library = RELEASE_RUNTIME,
+  .symbols = true,
+  .compile_flags = PLATFORM == WINDOWS ? std::vector<std::string>{"/O2"} : std::vector<std::string>{"-O2"},
+};
+
 namespace csb::utility
 {
   inline task current_task{};
+  // Whether watch was given on the command line, which rebuilds on every change and runs too if run was also given.
+  inline bool watch_requested{};
+  // Whether daemon was given on the command line, which starts a background process that serves later invocations.
+  inline bool daemon_requested{};
+  // The configuration names selected with --config, resolved against `configurations` after configure.
+  inline std::vector<std::string> configuration_names{};
+  // The configurations that compile and link schedule work for, the first one being the active configuration.
+  inline std::vector<configuration> build_configurations{};
+  // The configurations a parent project selected, used by a subproject for any it does not define itself.
+  inline std::vector<configuration> inherited_configurations{};
+
+  // Converts a configuration into JSON to hand it to subprojects.
+  inline nlohmann::json configuration_json(const configuration &item)
+  {
+    return {{"name", item.name},
+            {"directory", item.directory.generic_string()},
+            {"runtime_library", item.runtime_library},
+            {"symbols", item.symbols},
+            {"split_dwarf", item.split_dwarf},
+            {"package_dwarf", item.package_dwarf},
+            {"gdb_index", item.gdb_index},
+            {"debug_compression", item.debug_compression},
+            {"compile_flags", item.compile_flags},
+            {"link_flags", item.link_flags},
+            {"definitions", item.definitions}};
+  }
+
+  // Reads a configuration handed down by a parent project.
+  inline configuration json_configuration(const nlohmann::json &object)
+  {
+    return {.name = object.at("name").get<std::string>(),
+            .directory = object.at("directory").get<std::string>(),
+            .runtime_library = object.at("runtime_library").get<runtime>(),
+            .symbols = object.at("symbols").get<bool>(),
+            .split_dwarf = object.at("split_dwarf").get<bool>(),
+            .package_dwarf = object.at("package_dwarf").get<bool>(),
+            .gdb_index = object.at("gdb_index").get<bool>(),
+            .debug_compression = object.at("debug_compression").get<std::string>(),
+            .compile_flags = object.at("compile_flags").get<std::vector<std::string>>(),
+            .link_flags = object.at("link_flags").get<std::vector<std::string>>(),
+            .definitions = object.at("definitions").get<std::vector<std::string>>()};
+  }
+
+  inline std::vector<std::string> split_configuration_names(const std::string_view list)
+  {
+    std::vector<std::string> names{};
+    std::size_t start{};
+    while (start <= list.size())
+    {
+      auto end{list.find(',', start)};
+      if (end == std::string_view::npos) end = list.size();
+      if (end > start) names.emplace_back(list.substr(start, end - start));
+      start = end + 1;
+    }
+    return names;
+  }
 
   inline void handle_arguments(const std::vector<std::string_view> &args)
   {
-    if (args.empty()) throw std::runtime_error("Usage: csb [clean|build|run] [custom_arguments]");
+    if (args.empty())
+      throw std::runtime_error(
+        "Usage: csb [clean|build|run|watch|daemon [stop]] [--config name[,name...]] [custom_arguments]");
 
-    for (const auto &arg : args)
+    for (std::size_t index{}; index < args.size(); ++index)
     {
+      const auto &arg{args.at(index)};
       if (arg == "clean")
         current_task = CLEAN;
       else if (arg == "build")
         current_task = BUILD;
       else if (arg == "run")
         current_task = RUN;
+      else if (arg == "watch")
+        watch_requested = true;
+      else if (arg == "daemon")
+        daemon_requested = true;
+      else if (arg == "--config")
+      {
+        if (++index == args.size()) throw std::runtime_error("No configuration given after --config.");
+        configuration_names = split_configuration_names(args.at(index));
+      }
+      else if (arg.starts_with("--config="))
+        configuration_names = split_configuration_names(arg.substr(9));
       else
         arguments.emplace_back(arg.data());
     }
@@ -29153,6 +30814,182 @@ namespace csb::utility
     return result;
   }
 
+  /**
+   * A placeholder string split into literal segments and placeholders, whose selection and method steps are parsed once
+   * per thread for each distinct placeholder. Expanding it appends every segment in order, so no searching or
+   * rewriting of the string happens per path list.
+   */
+  struct placeholder_template
+  {
+    enum operation : std::uint8_t
+    {
+      ALL,
+      FIRST,
+      LAST,
+      SINGLE,
+      RANGE,
+      EXCEPT,
+      TO_FILENAME,
+      TO_STEM,
+      TO_EXTENSION,
+      TO_PARENT_PATH,
+      TO_LEXICALLY_NORMAL,
+      TO_ABSOLUTE,
+      TO_RELATIVE,
+      TO_CANONICAL,
+      TO_QUOTED
+    };
+    struct step
+    {
+      operation type{};
+      int first{};
+      int last{};
+    };
+    struct steps
+    {
+      std::vector<step> selections{};
+      std::vector<operation> methods{};
+    };
+    struct segment
+    {
+      std::string literal{};
+      char open{};
+      const steps *placeholder{};
+    };
+    std::vector<segment> segments{};
+  };
+
+  // Parses the contents of a single placeholder into its selection and method steps.
+  inline placeholder_template::steps parse_placeholder_content(const std::string &content)
+  {
+    placeholder_template::steps parsed{};
+    std::vector<std::string> tokens{};
+    for (size_t start{}, end{}; end != std::string::npos; start = end + 1)
+    {
+      end = content.find('.', start);
+      if (auto token{content.substr(start, end == std::string::npos ? std::string::npos : end - start)}; !token.empty())
+        tokens.push_back(std::move(token));
+    }
+    // ALL takes the place of every other selection wherever it appears, so only methods may follow it.
+    const auto all{std::ranges::find(tokens, "ALL")};
+    if (all != tokens.end())
+    {
+      tokens.erase(all);
+      parsed.selections.push_back({placeholder_template::ALL});
+    }
+    auto index{[&tokens](size_t &position, const std::string &error) -> int
+               {
+                 if (++position >= tokens.size() ||
+                     !std::ranges::all_of(tokens.at(position), [](unsigned char digit) { return std::isdigit(digit); }))
+                   throw std::runtime_error(error);
+                 return std::stoi(tokens.at(position));
+               }};
+
+    static const std::unordered_map<std::string, placeholder_template::operation> methods{
+      {"filename", placeholder_template::TO_FILENAME},
+      {"stem", placeholder_template::TO_STEM},
+      {"extension", placeholder_template::TO_EXTENSION},
+      {"parent_path", placeholder_template::TO_PARENT_PATH},
+      {"lexically_normal", placeholder_template::TO_LEXICALLY_NORMAL},
+      {"absolute", placeholder_template::TO_ABSOLUTE},
+      {"relative", placeholder_template::TO_RELATIVE},
+      {"canonical", placeholder_template::TO_CANONICAL},
+      {"quoted", placeholder_template::TO_QUOTED}};
+    const bool selecting_all{!parsed.selections.empty()};
+    for (size_t position{}; position < tokens.size(); ++position)
+    {
+      const auto &token{tokens.at(position)};
+      const bool selecting{!selecting_all && parsed.methods.empty()};
+      if (selecting && token == "FIRST")
+        parsed.selections.push_back({placeholder_template::FIRST});
+      else if (selecting && token == "LAST")
+        parsed.selections.push_back({placeholder_template::LAST});
+      else if (selecting && token == "SINGLE")
+        parsed.selections.push_back(
+          {placeholder_template::SINGLE, index(position, "SINGLE requires an index: SINGLE.n")});
+      else if (selecting && token == "RANGE")
+      {
+        const int start{index(position, "RANGE requires two indices: RANGE.n.m")};
+        const int end{index(position, "RANGE requires two indices: RANGE.n.m")};
+        parsed.selections.push_back({placeholder_template::RANGE, start, end});
+      }
+      else if (selecting && token == "EXCEPT")
+        parsed.selections.push_back(
+          {placeholder_template::EXCEPT, index(position, "EXCEPT requires an index: EXCEPT.n")});
+      else if (const auto method{methods.find(token)}; method != methods.end())
+        parsed.methods.push_back(method->second);
+      else
+        throw std::runtime_error("Unknown path placeholder method: " + token + ".");
+    }
+    return parsed;
+  }
+
+  // Returns the parsed steps of a placeholder's contents, parsing them only the first time this thread sees them.
+  inline const placeholder_template::steps *placeholder_steps(const std::string &content)
+  {
+    thread_local std::unordered_map<std::string, placeholder_template::steps> parsed{};
+    if (const auto found{parsed.find(content)}; found != parsed.end()) return &found->second;
+    auto steps{parse_placeholder_content(content)};
+    if (parsed.size() >= 4096) parsed.clear();
+    return &parsed.emplace(content, std::move(steps)).first->second;
+  }
+
+  // Parses a placeholder string into literal segments and placeholders, resolving escaped parentheses and brackets.
+  inline placeholder_template parse_placeholder_template(const std::string &text)
+  {
+    placeholder_template parsed{};
+    std::string literal{};
+    auto flush{[&]
+               {
+                 if (literal.empty()) return;
+                 parsed.segments.push_back({.literal = std::move(literal)});
+                 literal.clear();
+               }};
+
+    for (size_t position{}; position < text.size(); ++position)
+    {
+      const char character{text.at(position)};
+      const bool opening{character == '(' || character == '['};
+      if (!opening && character != ')' && character != ']')
+      {
+        literal += character;
+        continue;
+      }
+      if (position + 1 < text.size() && text.at(position + 1) == character)
+      {
+        literal += character;
+        ++position;
+        continue;
+      }
+      if (!opening)
+      {
+        literal += character;
+        continue;
+      }
+
+      const char close{character == '(' ? ')' : ']'};
+      size_t end{position + 1};
+      for (; end < text.size(); ++end)
+        if (text.at(end) == close)
+        {
+          if (end + 1 >= text.size() || text.at(end + 1) != close) break;
+          ++end;
+        }
+      if (end >= text.size())
+      {
+        literal += character;
+        continue;
+      }
+
+      flush();
+      parsed.segments.push_back(
+        {.open = character, .placeholder = placeholder_steps(text.substr(position + 1, end - position - 1))});
+      position = end;
+    }
+    flush();
+    return parsed;
+  }
+
   /**
    * READ THIS TO UNDERSTAND THE CUSTOM PLACEHOLDER SYNTAX USED IN TASK FUNCTIONS.
    * THIS FUNCTION IS NOT FOR DIRECT USE.
@@ -29214,186 +31051,99 @@ namespace csb::utility
     const std::pair<std::vector<std::filesystem::path>, std::vector<std::filesystem::path>> &paths,
     const std::pair<std::vector<std::filesystem::path>, std::vector<std::filesystem::path>> &full_list = {})
   {
-    auto result{placeholder};
-
-    auto substitute{[&](const std::string &from, const std::string &next)
-                    {
-                      size_t pos = 0;
-                      while ((pos = result.find(from, pos)) != std::string::npos)
-                      {
-                        result.replace(pos, from.length(), next);
-                        pos += next.length();
-                      }
-                    }};
+    const auto parsed{parse_placeholder_template(placeholder)};
+    std::string result{};
+    result.reserve(placeholder.size());
 
-    auto apply_selection{
-      [](std::string &content, const std::vector<std::filesystem::path> &source) -> std::vector<std::filesystem::path>
+    std::vector<const std::filesystem::path *> chosen{};
+    for (const auto &segment : parsed.segments)
+    {
+      if (!segment.open)
       {
-        std::vector<std::filesystem::path> chosen{};
-        size_t search_pos{};
-
-        auto erase_and_dot{[&](size_t pos, size_t len)
-                           {
-                             content.erase(pos, len);
-                             if (pos < content.size() && content.at(pos) == '.') content.erase(pos, 1);
-                           }};
+        result += segment.literal;
+        continue;
+      }
 
-        while (search_pos < content.size())
+      const auto &[selections, methods]{*segment.placeholder};
+      const bool check{segment.open == '['};
+      const auto &default_paths{check ? paths.second : paths.first};
+      const auto &all_paths{check ? full_list.second : full_list.first};
+      const bool all{!selections.empty() && selections.front().type == placeholder_template::ALL};
+      if (all && all_paths.empty()) throw std::runtime_error("Path placeholder 'ALL' requires multi_task_run().");
+      if (!all && default_paths.empty())
+        throw std::runtime_error(
+          std::format("Path placeholder '{}{}' requires task_run() with target and check paths.", segment.open,
+                      check ? ']' : ')'));
+      const auto &source{all ? all_paths : default_paths};
+
+      chosen.clear();
+      auto choose{[&chosen](const std::filesystem::path &path)
+                  {
+                    if (std::ranges::none_of(chosen, [&path](const auto *item) { return *item == path; }))
+                      chosen.push_back(&path);
+                  }};
+      for (const auto &[type, first, last] : selections)
+      {
+        if (type == placeholder_template::FIRST)
+          choose(source.front());
+        else if (type == placeholder_template::LAST)
+          choose(source.back());
+        else if (type == placeholder_template::SINGLE)
         {
-          if (auto first_pos{content.find("FIRST", search_pos)}; first_pos != std::string::npos)
-          {
-            if (source.empty()) throw std::runtime_error("FIRST requires at least one path.");
-            if (std::ranges::find(chosen, source.front()) == chosen.end()) chosen.push_back(source.front());
-            erase_and_dot(first_pos, 5);
-            search_pos = first_pos;
-          }
-          else if (auto last_pos{content.find("LAST", search_pos)}; last_pos != std::string::npos)
-          {
-            if (source.empty()) throw std::runtime_error("LAST requires at least one path.");
-            if (std::ranges::find(chosen, source.back()) == chosen.end()) chosen.push_back(source.back());
-            erase_and_dot(last_pos, 4);
-            search_pos = last_pos;
-          }
-          else if (auto single_pos{content.find("SINGLE.", search_pos)}; single_pos != std::string::npos)
-          {
-            size_t element{single_pos + 7};
-            while (element < content.size() && std::isdigit(content.at(element))) ++element;
-            auto index{std::stoi(content.substr(single_pos + 7, element - (single_pos + 7)))};
-            if (index < 1 || std::cmp_greater(index, static_cast<int>(source.size())))
-              throw std::runtime_error("SINGLE index out of bounds.");
-            if (std::ranges::find(chosen, source.at(static_cast<size_t>(index - 1))) == chosen.end())
-              chosen.push_back(source.at(static_cast<size_t>(index - 1)));
-            erase_and_dot(single_pos, element - single_pos);
-            search_pos = single_pos;
-          }
-          else if (auto range_pos{content.find("RANGE.", search_pos)}; range_pos != std::string::npos)
-          {
-            const size_t dot1{content.find('.', range_pos + 6)};
-            if (dot1 == std::string::npos) throw std::runtime_error("RANGE requires two indices: RANGE.n.m");
-            size_t element{dot1 + 1};
-            while (element < content.size() && std::isdigit(content.at(element))) ++element;
-            const int start{std::stoi(content.substr(range_pos + 6, dot1 - (range_pos + 6)))};
-            const int end{std::stoi(content.substr(dot1 + 1, element - (dot1 + 1)))};
-            if (start < 1 || end < 1 || std::cmp_greater(start, static_cast<int>(source.size())) ||
-                std::cmp_greater(end, static_cast<int>(source.size())))
-              throw std::runtime_error("RANGE indices out of bounds.");
-            if (start > end) throw std::runtime_error("RANGE start index must be <= end index.");
-            for (int index{start}; index <= end; ++index)
-              if (std::ranges::find(chosen, source.at(static_cast<size_t>(index - 1))) == chosen.end())
-                chosen.push_back(source.at(static_cast<size_t>(index - 1)));
-            erase_and_dot(range_pos, element - range_pos);
-            search_pos = range_pos;
-          }
-          else if (auto except_pos{content.find("EXCEPT.", search_pos)}; except_pos != std::string::npos)
-          {
-            size_t element{except_pos + 7};
-            while (element < content.size() && std::isdigit(content.at(element))) ++element;
-            const int index{std::stoi(content.substr(except_pos + 7, element - (except_pos + 7)))};
-            if (index < 1 || std::cmp_greater(index, static_cast<int>(chosen.size())))
-              throw std::runtime_error("EXCEPT index out of bounds.");
-            chosen.erase(chosen.begin() + (index - 1));
-            erase_and_dot(except_pos, element - except_pos);
-            search_pos = except_pos;
-          }
-          else
-            break;
+          if (first < 1 || std::cmp_greater(first, source.size()))
+            throw std::runtime_error("SINGLE index out of bounds.");
+          choose(source.at(static_cast<size_t>(first - 1)));
         }
-        return chosen;
-      }};
-
-    auto apply_methods{
-      [](std::vector<std::filesystem::path> &chosen_paths, const std::string &content)
-      {
-        if (content.empty()) return;
-        for (auto &path : chosen_paths)
+        else if (type == placeholder_template::RANGE)
         {
-          size_t method_start{};
-          size_t method_end{};
-          while (method_end != std::string::npos)
-          {
-            method_end = content.find('.', method_start);
-            auto method{content.substr(method_start, method_end == std::string::npos ? std::string::npos
-                                                                                     : method_end - method_start)};
-            if (!method.empty())
-            {
-              if (method == "filename")
-                path = path.filename();
-              else if (method == "stem")
-                path = path.stem();
-              else if (method == "extension")
-                path = path.extension();
-              else if (method == "parent_path")
-                path = path.has_parent_path() ? path.parent_path() : path;
-              else if (method == "lexically_normal")
-                path = path.lexically_normal();
-              else if (method == "absolute")
-                path = std::filesystem::absolute(path);
-              else if (method == "relative")
-                path = std::filesystem::relative(path);
-              else if (method == "canonical")
-                path = std::filesystem::canonical(path);
-              else if (method == "quoted")
-                path = std::format("\"{}\"", path.string());
-              else
-                throw std::runtime_error("Unknown path placeholder method: " + method + ".");
-            }
-            method_start = method_end + 1;
-          }
+          if (first < 1 || last < 1 || std::cmp_greater(first, source.size()) || std::cmp_greater(last, source.size()))
+            throw std::runtime_error("RANGE indices out of bounds.");
+          if (first > last) throw std::runtime_error("RANGE start index must be <= end index.");
+          for (int index{first}; index <= last; ++index) choose(source.at(static_cast<size_t>(index - 1)));
         }
-      }};
-
-    auto process{[&](char open, char close, const std::vector<std::filesystem::path> &default_paths,
-                     const std::vector<std::filesystem::path> &all_paths)
-                 {
-                   size_t pos{};
-                   const std::string open_str(1, open), close_str(1, close);
-                   while ((pos = result.find(open_str, pos)) != std::string::npos)
-                   {
-                     const size_t end_pos{result.find(close_str, pos)};
-                     if (end_pos == std::string::npos) break;
-
-                     auto content{result.substr(pos + 1, end_pos - pos - 1)};
-                     std::vector<std::filesystem::path> chosen{};
-
-                     if (const size_t all_pos{content.find("ALL")}; all_pos != std::string::npos)
-                     {
-                       if (all_paths.empty())
-                         throw std::runtime_error("Path placeholder 'ALL' requires multi_task_run().");
-                       chosen = all_paths;
-                       content.erase(all_pos, 3);
-                       if (all_pos < content.size() && content.at(all_pos) == '.') content.erase(all_pos, 1);
-                     }
-                     else
-                     {
-                       if (default_paths.empty())
-                         throw std::runtime_error(std::format(
-                           "Path placeholder '{}{}' requires task_run() with target and check paths.", open, close));
-                       chosen = apply_selection(content, default_paths);
-                       if (chosen.empty()) chosen = default_paths;
-                     }
-
-                     apply_methods(chosen, content);
-                     auto replacement{unpack(chosen)};
-                     result.replace(pos, end_pos - pos + 1, replacement);
-                     pos += replacement.length();
-                   }
-                 }};
-
-    substitute("((", "\x01");
-    substitute("))", "\x02");
-    substitute("[[", "\x03");
-    substitute("]]", "\x04");
-
-    const auto &[target_paths, check_paths]{paths};
-    const auto &[full_target_paths, full_check_paths]{full_list};
-    process('(', ')', target_paths, full_target_paths);
-    process('[', ']', check_paths, full_check_paths);
-
-    substitute("\x01", "(");
-    substitute("\x02", ")");
-    substitute("\x03", "[");
-    substitute("\x04", "]");
+        else if (type == placeholder_template::EXCEPT)
+        {
+          if (first < 1 || std::cmp_greater(first, chosen.size()))
+            throw std::runtime_error("EXCEPT index out of bounds.");
+          chosen.erase(chosen.begin() + (first - 1));
+        }
+      }
+      if (chosen.empty())
+        for (const auto &path : source) chosen.push_back(&path);
 
+      for (size_t index{}; index < chosen.size(); ++index)
+      {
+        if (index) result += ' ';
+        if (methods.empty())
+        {
+          result += chosen.at(index)->string();
+          continue;
+        }
+        auto path{*chosen.at(index)};
+        for (const auto method : methods)
+        {
+          if (method == placeholder_template::TO_FILENAME)
+            path = path.filename();
+          else if (method == placeholder_template::TO_STEM)
+            path = path.stem();
+          else if (method == placeholder_template::TO_EXTENSION)
+            path = path.extension();
+          else if (method == placeholder_template::TO_PARENT_PATH)
+            path = path.has_parent_path() ? path.parent_path() : path;
+          else if (method == placeholder_template::TO_LEXICALLY_NORMAL)
+            path = path.lexically_normal();
+          else if (method == placeholder_template::TO_ABSOLUTE)
+            path = std::filesystem::absolute(path);
+          else if (method == placeholder_template::TO_RELATIVE)
+            path = std::filesystem::relative(path);
+          else if (method == placeholder_template::TO_CANONICAL)
+            path = std::filesystem::canonical(path);
+          else if (method == placeholder_template::TO_QUOTED)
+            path = std::format("\"{}\"", path.string());
+        }
+        result += path.string();
+      }
+    }
     return result;
   }
 
@@ -29441,17 +31191,16 @@ namespace csb::utility
                                          const std::string &, const int, const std::string &)> &on_failure = {})
   {
     std::vector<std::filesystem::path> all_items{};
-    std::vector<std::filesystem::path> all_dependencies{};
+    path_set dependency_set{};
     if constexpr (std::same_as<std::remove_cvref_t<container>, std::vector<std::filesystem::path>>)
       all_items = std::vector<std::filesystem::path>(items.begin(), items.end());
     else
       for (const auto &item : items)
       {
         all_items.push_back(item.first);
-        for (const auto &dependency : item.second)
-          if (std::find(all_dependencies.begin(), all_dependencies.end(), dependency) == all_dependencies.end())
-            all_dependencies.push_back(dependency);
+        for (const auto &dependency : item.second) dependency_set.insert(dependency);
       }
+    const auto &all_dependencies{dependency_set.paths};
 
     std::vector<std::exception_ptr> exceptions{};
     std::mutex exceptions_mutex{};
@@ -29602,81 +31351,154 @@ namespace csb::utility
     if (on_success) on_success(real_command);
   }
 
-  inline std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> find_modified_files(
-    const std::vector<std::filesystem::path> &target_files, const std::vector<std::filesystem::path> &check_files,
-    const std::function<bool(const std::filesystem::path &, const std::vector<std::filesystem::path> &)>
-      &dependency_handler = {})
+  // Returns the latest modification time of the build script, which every check file has to be newer than.
+  inline std::filesystem::file_time_type build_script_time()
   {
-    std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> modified_files{};
+    auto time{std::filesystem::file_time_type::min()};
+    for (const auto &file : {std::filesystem::path{"csb"} / "csb.hpp", std::filesystem::path{"csb"} / "csb.cpp"})
+      if (std::filesystem::exists(file)) time = std::max(time, std::filesystem::last_write_time(file));
+    return time;
+  }
+
+  // Maps every target file to its check files with their placeholders expanded for that target file.
+  inline std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> expand_check_files(
+    const std::vector<std::filesystem::path> &target_files, const std::vector<std::filesystem::path> &check_files)
+  {
+    std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> expanded_files{};
+    expanded_files.reserve(target_files.size());
     for (const auto &target_file : target_files)
     {
       std::vector<std::filesystem::path> target_check_files{};
       target_check_files.reserve(check_files.size());
       for (const auto &check_file : check_files)
         target_check_files.emplace_back(placeholder_path_replace(check_file.string(), {{target_file}, {check_file}}));
+      expanded_files.insert({target_file, std::move(target_check_files)});
+    }
+    return expanded_files;
+  }
 
-      std::vector<std::filesystem::path> valid_files{};
-      bool any_missing{};
-      for (const auto &check_file : check_files)
-      {
-        const std::filesystem::path check_path{
-          placeholder_path_replace(check_file.string(), {{target_file}, {check_file}})};
-        if (!std::filesystem::exists(check_path))
-        {
-          any_missing = true;
-          break;
-        }
-        valid_files.push_back(check_path);
-      }
-      if (any_missing)
-      {
-        modified_files.insert({target_file, target_check_files});
-        continue;
-      }
+  // Checks whether a target file is out of date with respect to its expanded check files.
+  inline bool is_modified(
+    const std::filesystem::path &target_file, const std::vector<std::filesystem::path> &target_check_files,
+    const std::function<bool(const std::filesystem::path &, const std::vector<std::filesystem::path> &)>
+      &dependency_handler,
+    const std::filesystem::file_time_type script_time, file_times &times)
+  {
+    std::vector<std::filesystem::file_time_type> check_times{};
+    check_times.reserve(target_check_files.size());
+    for (const auto &check_path : target_check_files)
+    {
+      const auto time{times.at(check_path)};
+      if (!time) return true;
+      check_times.push_back(*time);
+    }
 
-      std::filesystem::file_time_type csb_header_time{};
-      if (!std::filesystem::exists(std::filesystem::path{"csb"} / "csb.hpp"))
-        csb_header_time = std::filesystem::file_time_type::min();
-      else
-        csb_header_time = std::filesystem::last_write_time(std::filesystem::path{"csb"} / "csb.hpp");
-      std::filesystem::file_time_type csb_source_time{};
-      if (!std::filesystem::exists(std::filesystem::path{"csb"} / "csb.cpp"))
-        csb_source_time = std::filesystem::file_time_type::min();
-      else
-        csb_source_time = std::filesystem::last_write_time(std::filesystem::path{"csb"} / "csb.cpp");
-      auto source_time{std::filesystem::last_write_time(target_file)};
+    const auto source_time{times.at(target_file)};
+    if (!source_time) throw std::runtime_error("Failed to read modification time: " + target_file.string() + ".");
+    for (const auto time : check_times)
+      if (*source_time > time || script_time > time) return true;
+
+    if (!dependency_handler) return false;
+    try
+    {
+      return dependency_handler(target_file, target_check_files);
+    }
+    catch (const std::exception &)
+    {
+      return true;
+    }
+  }
 
-      bool needs_rebuild{};
-      for (const auto &file : valid_files)
+  /**
+   * Returns a check that is run in place of `find_modified_files` right before a job starts, so that jobs can begin
+   * while other files are still being checked. A check that fails counts as out of date, which lets the job itself
+   * report the problem.
+   */
+  inline std::function<bool()> deferred_modified_check(
+    const std::filesystem::path &target_file, const std::vector<std::filesystem::path> &target_check_files,
+    const std::function<bool(const std::filesystem::path &, const std::vector<std::filesystem::path> &)>
+      &dependency_handler,
+    const std::filesystem::file_time_type script_time, const std::shared_ptr<file_times> &times)
+  {
+    return [=]()
+    {
+      try
       {
-        auto time{std::filesystem::last_write_time(file)};
-        if (source_time > time || csb_header_time > time || csb_source_time > time)
-        {
-          needs_rebuild = true;
-          break;
-        }
+        return is_modified(target_file, target_check_files, dependency_handler, script_time, *times);
       }
-      if (needs_rebuild)
+      catch (const std::exception &)
       {
-        modified_files.insert({target_file, target_check_files});
-        continue;
-      }
-
-      if (dependency_handler)
-      {
-        try
-        {
-          if (dependency_handler(target_file, valid_files)) modified_files.insert({target_file, target_check_files});
-        }
-        catch (const std::exception &)
-        {
-          modified_files.insert({target_file, target_check_files});
-        }
+        return true;
       }
+    };
+  }
+
+  // Gathers the modification times of target files and their expanded check files in one batch, recording the target
+  // files as inputs for watch mode.
+  inline void gather_file_times(
+    file_times &times,
+    const std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> &expanded_files)
+  {
+    std::vector<std::filesystem::path> paths{};
+    for (const auto &[target_file, target_check_files] : expanded_files)
+    {
+      paths.push_back(target_file);
+      paths.insert(paths.end(), target_check_files.begin(), target_check_files.end());
     }
+    times.gather(paths);
+    if (!watching) return;
+    std::vector<std::filesystem::path> target_files{};
+    for (const auto &entry : expanded_files) target_files.push_back(entry.first);
+    record_inputs(target_files);
+  }
+
+  // Returns the target files that are out of date mapped to their expanded check files, checking them in parallel.
+  inline std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> find_modified_files(
+    std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> expanded_files,
+    const std::function<bool(const std::filesystem::path &, const std::vector<std::filesystem::path> &)>
+      &dependency_handler = {})
+  {
+    const auto script_time{build_script_time()};
+    file_times times{};
+    gather_file_times(times, expanded_files);
+    std::vector<std::pair<const std::filesystem::path, std::vector<std::filesystem::path>> *> entries{};
+    entries.reserve(expanded_files.size());
+    for (auto &entry : expanded_files) entries.push_back(&entry);
+
+    std::vector<char> modified(entries.size());
+    std::exception_ptr exception{};
+    std::mutex exception_mutex{};
+    std::transform(std::execution::par, entries.begin(), entries.end(), modified.begin(),
+                   [&](const auto *entry) -> char
+                   {
+                     try
+                     {
+                       return is_modified(entry->first, entry->second, dependency_handler, script_time, times);
+                     }
+                     catch (...)
+                     {
+                       const std::scoped_lock<std::mutex> lock(exception_mutex);
+                       if (!exception) exception = std::current_exception();
+                       return false;
+                     }
+                   });
+    if (exception) std::rethrow_exception(exception);
+
+    std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> modified_files{};
+    for (size_t index{}; index < entries.size(); ++index)
+      if (modified.at(index)) modified_files.insert({entries.at(index)->first, std::move(entries.at(index)->second)});
     return modified_files;
   }
 
+  // Returns the target files that are out of date mapped to their check files, expanding the check file placeholders.
+  inline std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> find_modified_files(
+    const std::vector<std::filesystem::path> &target_files, const std::vector<std::filesystem::path> &check_files,
+    const std::function<bool(const std::filesystem::path &, const std::vector<std::filesystem::path> &)>
+      &dependency_handler = {})
+  {
+    return find_modified_files(expand_check_files(target_files, check_files), dependency_handler);
+  }
+
   inline std::filesystem::path bootstrap_vcpkg(std::string vcpkg_version)
   {
     bool needs_bootstrap{};
@@ -30002,10 +31824,25 @@ namespace csb
   inline subsystem target_subsystem{CONSOLE};
   // The build configuration of the project.
   inline configuration target_configuration{RELEASE};
+  // The build configurations that can be selected by name, add custom configurations here to make them selectable.
+  // Subprojects are handed the definitions of the selected configurations and use them for names they do not define.
+  inline std::vector<configuration> configurations{DEBUG, RELEASE, PROFILE, RELWITHDEBINFO};
   // The C++ standard of the project.
   inline standard cxx_standard{CXX20};
   // The warning level of the project.
   inline warning warning_level{W4};
+  // Whether objects are combined per source directory into partial links before the final link (only affects Linux).
+  inline bool partial_links{};
+  // A directory shared between projects that keeps compiled precompiled headers by content, so projects and targets
+  // with identical headers and flags reuse them, empty to disable (only affects Linux).
+  inline std::filesystem::path precompiled_header_store{};
+  // The most small source files passed to a single compiler invocation, 1 compiles every file on its own (only affects
+  // Linux).
+  inline std::size_t batch_size{1};
+  // The size in bytes up to which a source file counts as small enough to be batched.
+  inline std::uintmax_t batch_file_size{16384};
+  // Whether static libraries are thin archives that reference their objects rather than copy them (only affects Linux).
+  inline bool thin_archives{};
 
   // The target's source files.
   inline std::vector<std::filesystem::path> source_files{};
@@ -30021,6 +31858,57 @@ namespace csb
   inline std::vector<std::string> libraries{};
   // The target's source file's preprocessor definitions.
   inline std::vector<std::string> definitions{};
+  // The target's precompiled headers that are force included into a list of sources, or into every source if the list
+  // is empty; when set, sources are no longer scanned for the precompiled header they include.
+  inline std::vector<std::pair<std::filesystem::path, std::vector<std::filesystem::path>>>
+    precompiled_header_sources{};
+  // Object files that are linked into the target as they are, such as those written by `embed_object`.
+  inline std::vector<std::filesystem::path> object_files{};
+
+  /**
+   * A target that can be built alongside other targets with the multi-target overloads of compile and link.
+   *
+   * The fields mirror the global target settings. `dependencies` names other targets given in the same call; those are
+   * linked first and their library artifacts are linked into this target.
+   */
+  struct target
+  {
+    std::string name{"a"};
+    artifact artifact_type{EXECUTABLE};
+    linkage linkage_type{STATIC};
+    subsystem subsystem_type{CONSOLE};
+    std::vector<std::filesystem::path> source_files{};
+    std::vector<std::filesystem::path> include_files{};
+    std::vector<std::filesystem::path> precompiled_headers{};
+    std::vector<std::filesystem::path> external_include_directories{};
+    std::vector<std::filesystem::path> library_directories{};
+    std::vector<std::string> libraries{};
+    std::vector<std::string> definitions{};
+    std::vector<std::pair<std::filesystem::path, std::vector<std::filesystem::path>>> precompiled_header_sources{};
+    std::vector<std::filesystem::path> object_files{};
+    std::vector<std::string> dependencies{};
+  };
+
+  // Returns the configuration from `configurations`, or from a parent project's selection, with a specified name,
+  // ignoring case.
+  inline configuration find_configuration(const std::string &name)
+  {
+    auto lower{[](std::string string)
+               {
+                 std::ranges::transform(string, string.begin(), [](const unsigned char character)
+                                        { return static_cast<char>(std::tolower(character)); });
+                 return string;
+               }};
+    for (const auto &candidate : configurations)
+      if (lower(candidate.name) == lower(name)) return candidate;
+    for (const auto &candidate : utility::inherited_configurations)
+      if (lower(candidate.name) == lower(name)) return candidate;
+    throw std::runtime_error("Unknown configuration: " + name + ".");
+  }
+
+  // Returns the build directory of the active configuration.
+  inline std::filesystem::path configuration_directory()
+  { return std::filesystem::path{"build"} / target_configuration.directory; }
 
   /**
    * Runs a task unconditionally.
@@ -30122,7 +32010,8 @@ namespace csb
    *                 placeholders for target files.
    * | `dependency_handler`: Can be provided to specify custom dependencies between target and check files, which takes
    *                         a target file and that file's expanded check files as arguments and returns true if the
-   *                         target file is out of date.
+   *                         target file is out of date. Target files are checked in parallel, so it can be called
+   *                         from several threads at once.
    *
    * See also: `multi_task_run`, `live_task_run`.
    */
@@ -30139,17 +32028,13 @@ namespace csb
     if (modified_files.empty()) return;
     print<COUT>("\n{}\n", utility::small_section_divider());
 
-    std::vector<std::filesystem::path> dependency_files{};
+    utility::path_set dependency_set{};
     for (const auto &target_file : target_files)
     {
       for (const auto &check_file : check_files)
-      {
-        auto dependency{
-          std::filesystem::path{utility::placeholder_path_replace(check_file.string(), {{target_file}, {}})}};
-        if (std::ranges::find(dependency_files, dependency) == dependency_files.end())
-          dependency_files.push_back(dependency);
-      }
+        dependency_set.insert(utility::placeholder_path_replace(check_file.string(), {{target_file}, {}}));
     }
+    const auto &dependency_files{dependency_set.paths};
     auto on_start{[&dependency_files](const std::string &)
                   {
                     for (const auto &dependency : dependency_files)
@@ -30254,7 +32139,8 @@ namespace csb
    *                  files can contain placeholders for target files.
    * | `dependency_handler`: Can be provided to specify custom dependencies between target and check files, which takes
    *                         a target file and that file's expanded check files as arguments and returns true if the
-   *                         target file is out of date.
+   *                         target file is out of date. Target files are checked in parallel, so it can be called
+   *                         from several threads at once.
    *
    * See also: `task_run`, `live_task_run`.
    */
@@ -30272,16 +32158,11 @@ namespace csb
     if (modified_files.empty()) return;
     print<COUT>("\n{}", utility::small_section_divider());
 
-    auto on_start{[&target_files, &check_files](const std::filesystem::path &,
-                                                const std::vector<std::filesystem::path> &, const std::string &)
+    auto on_start{[](const std::filesystem::path &, const std::vector<std::filesystem::path> &dependencies,
+                     const std::string &)
                   {
-                    for (const auto &target_file : target_files)
-                      for (const auto &check_file : check_files)
-                      {
-                        auto dependency{std::filesystem::path{
-                          utility::placeholder_path_replace(check_file.string(), {{target_file}, {}})}};
-                        if (dependency.has_parent_path()) std::filesystem::create_directories(dependency.parent_path());
-                      }
+                    for (const auto &dependency : dependencies)
+                      if (dependency.has_parent_path()) std::filesystem::create_directories(dependency.parent_path());
                   }};
     auto on_success{[](const std::filesystem::path &, const std::vector<std::filesystem::path> &dependencies,
                        const std::string &item_command, const std::string &output)
@@ -30395,7 +32276,8 @@ namespace csb
    *                  placeholders for target files.
    * | `dependency_handler`: Can be provided to specify custom dependencies between target and check files, which takes
    *                         a target file and that file's expanded check files as arguments and returns true if the
-   *                         target file is out of date.
+   *                         target file is out of date. Target files are checked in parallel, so it can be called
+   *                         from several threads at once.
    *
    * See also: `task_run`, `multi_task_run`.
    */
@@ -30412,15 +32294,11 @@ namespace csb
     if (modified_files.empty()) return;
     print<COUT>("\n{}\n", utility::small_section_divider());
 
-    std::vector<std::filesystem::path> dependency_files{};
+    utility::path_set dependency_set{};
     for (const auto &target_file : target_files)
       for (const auto &check_file : check_files)
-      {
-        auto dependency{
-          std::filesystem::path{utility::placeholder_path_replace(check_file.string(), {{target_file}, {}})}};
-        if (std::ranges::find(dependency_files, dependency) == dependency_files.end())
-          dependency_files.push_back(dependency);
-      }
+        dependency_set.insert(utility::placeholder_path_replace(check_file.string(), {{target_file}, {}}));
+    const auto &dependency_files{dependency_set.paths};
     auto on_start{[&dependency_files](const std::string &real_command)
                   {
                     print<COUT>("{}\n", real_command);
@@ -30585,14 +32463,14 @@ namespace csb
     std::string vcpkg_triplet{};
     if (host_platform == WINDOWS)
       vcpkg_triplet = std::format("{}-windows{}{}", host_architecture, (target_linkage == STATIC ? "-static" : ""),
-                                  (target_configuration == RELEASE ? "-release" : ""));
+                                  (target_configuration.runtime_library == RELEASE_RUNTIME ? "-release" : ""));
     else if (host_platform == LINUX)
       vcpkg_triplet = std::format("{}-linux", host_architecture);
     auto vcpkg_installed_directory{std::filesystem::path{"build"} / "vcpkg_installed"};
     const std::pair<std::filesystem::path, std::filesystem::path> outputs{
       vcpkg_installed_directory / vcpkg_triplet / "include",
       vcpkg_installed_directory / vcpkg_triplet /
-        (target_configuration == RELEASE ? "lib" : std::filesystem::path{"debug"} / "lib")};
+        (target_configuration.runtime_library == RELEASE_RUNTIME ? "lib" : std::filesystem::path{"debug"} / "lib")};
     auto manifest_path{vcpkg_path.parent_path() / "vcpkg.json"};
     auto manifest_time{std::filesystem::exists(manifest_path) ? std::filesystem::last_write_time(manifest_path)
                                                               : std::filesystem::file_time_type::min()};
@@ -30621,8 +32499,8 @@ namespace csb
         [](const std::string &, const int return_code)
         { throw std::runtime_error("Failed to install vcpkg packages. Exited with: " + std::to_string(return_code)); });
 
-    if (std::filesystem::exists(outputs.first)) external_include_directories.push_back(outputs.first);
-    if (std::filesystem::exists(outputs.second)) library_directories.push_back(outputs.second);
+    if (std::filesystem::exists(outputs.first)) utility::add_directory(external_include_directories, outputs.first);
+    if (std::filesystem::exists(outputs.second)) utility::add_directory(library_directories, outputs.second);
   }
   /**
    * Installs vcpkg packages using an optional version anchor.
@@ -30642,7 +32520,7 @@ namespace csb
   {
     if (host_platform == WINDOWS)
       return std::format("{}-windows{}{}", host_architecture, (target_linkage == STATIC ? "-static" : ""),
-                         (target_configuration == RELEASE ? "-release" : ""));
+                         (target_configuration.runtime_library == RELEASE_RUNTIME ? "-release" : ""));
     return std::format("{}-linux", host_architecture);
   }
   // The local vcpkg include directory for the active triplet.
@@ -30652,7 +32530,7 @@ namespace csb
   inline std::filesystem::path vcpkg_library()
   {
     return std::filesystem::path{"build"} / "vcpkg_installed" / vcpkg_triplet() /
-           (target_configuration == RELEASE ? "lib" : std::filesystem::path{"debug"} / "lib");
+           (target_configuration.runtime_library == RELEASE_RUNTIME ? "lib" : std::filesystem::path{"debug"} / "lib");
   }
 
   /**
@@ -30677,7 +32555,7 @@ namespace csb
 
     auto repo_name{name.substr(name.find('/') + 1)};
     auto subproject_path{subproject_directory / repo_name};
-    auto build_path{subproject_path / "build" / (target_configuration == RELEASE ? "release" : "debug")};
+    auto build_path{subproject_path / "build" / target_configuration.directory};
     auto bootstrapped = utility::bootstrap_subproject(subproject_path, name, version);
 
     auto subproject_time{std::filesystem::exists(subproject_path) ? std::filesystem::last_write_time(subproject_path)
@@ -30688,10 +32566,15 @@ namespace csb
     auto csb_hpp_time{std::filesystem::exists(std::filesystem::path{"csb"} / "csb.hpp")
                         ? std::filesystem::last_write_time(std::filesystem::path{"csb"} / "csb.hpp")
                         : std::filesystem::file_time_type::min()};
-    if (subproject_time < csb_cpp_time || subproject_time < csb_hpp_time || bootstrapped ||
-        !std::filesystem::exists(build_path) || is_subproject)
+    auto missing_build{!std::filesystem::exists(build_path)};
+    for (const auto &item : utility::build_configurations)
+      if (!std::filesystem::exists(subproject_path / "build" / item.directory)) missing_build = true;
+    if (subproject_time < csb_cpp_time || subproject_time < csb_hpp_time || bootstrapped || missing_build ||
+        is_subproject)
     {
       print<COUT>("\n{}\n", utility::big_section_divider());
+      for (const auto &item : utility::build_configurations)
+        std::filesystem::create_directories(subproject_path / "build" / item.directory);
       if (!std::filesystem::exists(build_path)) std::filesystem::create_directories(build_path);
       utility::live_execute(
         std::format("cd {} && {}{}{}", subproject_path.string(), host_platform == LINUX ? "./" : "",
@@ -30709,13 +32592,24 @@ namespace csb
     }
 
     if (subproject_type == STANDALONE)
-      append_environment_variable("PATH", std::filesystem::absolute(build_path).string());
+    {
+      const std::string separator{host_platform == WINDOWS ? ";" : ":"};
+      const auto binary_directory{std::filesystem::absolute(build_path).string()};
+      if ((separator + get_environment_variable("PATH") + separator).find(separator + binary_directory + separator) ==
+          std::string::npos)
+        append_environment_variable("PATH", binary_directory);
+    }
     else
     {
       auto include_path{subproject_path / "build" / "include"};
       if (std::filesystem::exists(include_path) && std::filesystem::is_directory(include_path))
-        external_include_directories.push_back(include_path);
-      if (subproject_type == COMPILED_LIBRARY) library_directories.push_back(build_path);
+        utility::add_directory(external_include_directories, include_path);
+      if (subproject_type == COMPILED_LIBRARY)
+      {
+        utility::add_directory(library_directories, build_path);
+        utility::subproject_builds[std::filesystem::path{build_path}.make_preferred()] =
+          std::filesystem::path{subproject_path / "build"}.make_preferred();
+      }
     }
   }
   /**
@@ -30742,7 +32636,7 @@ namespace csb
   inline std::filesystem::path subproject_library(const std::string &name)
   {
     return std::filesystem::path{"build"} / "subproject" / name.substr(name.find('/') + 1) / "build" /
-           (target_configuration == RELEASE ? "release" : "debug");
+           target_configuration.directory;
   }
 
   /**
@@ -30777,6 +32671,16 @@ namespace csb
    * | `resources`: A list of resource files to embed.
    * | `outputs`: A pair of output paths specifying where to write the generated header and source files respectively.
    * | `check_files`: A list of files that will trigger a re-run of the function if missing or changed.
+   * | `sharded`: Whether each resource's source content goes into a source file of its own, named after the source
+   *              output and the resource's generated name (for example "res_icon_png.cpp" next to "res.cpp"), instead
+   *              of into the source output; each of these starts with the source start content, is only regenerated
+   *              when its resource changes and is added to `source_files`, so that it compiles in parallel with the
+   *              other sources and touching one resource only recompiles its own file. The source output still
+   *              receives the start and end content. Shards of resources that are no longer embedded are deleted and
+   *              removed from `source_files`; without a source function nothing is sharded.
+   * | `parallel`: Whether the name, data, header, source and data format functions can be called from several threads
+   *               at once; when true, resources are read and formatted in parallel, while the generated files keep the
+   *               order the resources were given in.
    *
    * See also: `read_file`, `byte_to_hex`.
    */
@@ -30794,7 +32698,7 @@ namespace csb
         const std::function<bool(const std::filesystem::path &)> &accept_function,
         const std::vector<std::filesystem::path> &resources,
         const std::pair<std::filesystem::path, std::filesystem::path> &outputs,
-        const std::vector<std::filesystem::path> &check_files)
+        const std::vector<std::filesystem::path> &check_files, const bool sharded = false, const bool parallel = false)
   {
     if (resources.empty()) throw std::runtime_error("No resources to embed.");
     if (outputs.first.empty() || outputs.second.empty()) throw std::runtime_error("Embed output files not set.");
@@ -30807,7 +32711,8 @@ namespace csb
 
     auto substitute_file_data{
       [&](std::string placeholder, const std::string &name, const tuple &data,
-          const std::function<std::vector<std::string>(const std::string &, const tuple &)> &handler) -> std::string
+          const std::function<std::vector<std::string>(const std::string &, const tuple &)> &handler,
+          const std::function<void(std::string_view)> &write)
       {
         size_t pos{};
         while ((pos = placeholder.find("((", pos)) != std::string::npos)
@@ -30823,26 +32728,15 @@ namespace csb
         }
 
         std::vector<std::string> data_values{};
-        if (handler)
-          data_values = handler(name, data);
-        else
-        {
-          data_values.emplace_back("");
-          const std::vector<std::byte> &file_data_vector{std::get<0>(data)};
-          for (size_t index{}; index < file_data_vector.size(); ++index)
-          {
-            data_values.front() += byte_to_hex(file_data_vector.at(index));
-            if (index < file_data_vector.size() - 1)
-            {
-              data_values.front() += ",";
-              if ((index + 1) % 16 == 0)
-                data_values.front() += "\n    ";
-              else
-                data_values.front() += " ";
-            }
-          }
-        }
+        if (handler) data_values = handler(name, data);
+        auto write_text{[&](std::string text)
+                        {
+                          std::ranges::replace(text, '\x01', '(');
+                          std::ranges::replace(text, '\x02', ')');
+                          write(text);
+                        }};
 
+        size_t start{};
         pos = 0;
         while ((pos = placeholder.find('(', pos)) != std::string::npos)
         {
@@ -30852,46 +32746,548 @@ namespace csb
           auto index{placeholder.substr(pos + 1, end_pos - pos - 1)};
           if (index.empty() || !std::ranges::all_of(index, ::isdigit))
             throw std::runtime_error("Invalid data placeholder index: " + (index.empty() ? "null" : index) + ".");
-          if (std::stoull(index) >= data_values.size())
+          if (std::stoull(index) >= (handler ? data_values.size() : 1))
             throw std::runtime_error("Data placeholder index out of range: " + index + ".");
-          const auto &replacement{data_values.at(std::stoull(index))};
-          placeholder.replace(pos, end_pos - pos + 1, replacement);
-          pos += replacement.length();
+          write_text(placeholder.substr(start, pos - start));
+          if (handler)
+            write(data_values.at(std::stoull(index)));
+          else
+            utility::write_hex_bytes(std::get<0>(data), write);
+          pos = start = end_pos + 1;
         }
+        write_text(placeholder.substr(start));
+      }};
 
-        pos = 0;
-        while ((pos = placeholder.find('\x01', pos)) != std::string::npos)
-        {
-          placeholder.replace(pos, 1, "(");
-          pos += 1;
-        }
-        pos = 0;
-        while ((pos = placeholder.find('\x02', pos)) != std::string::npos)
-        {
-          placeholder.replace(pos, 1, ")");
-          pos += 1;
-        }
+    auto resource_name{[&](const std::filesystem::path &resource)
+                       {
+                         if (name_retrieval_function) return name_retrieval_function(resource);
+                         auto name{resource.filename().string()};
+                         std::ranges::replace(name, '.', '_');
+                         std::ranges::replace(name, '-', '_');
+                         return name;
+                       }};
 
-        return placeholder;
-      }};
+    // Without a source function there is no per resource source content, so nothing is sharded.
+    const bool sharding{sharded && static_cast<bool>(source_function)};
+    std::unordered_map<std::filesystem::path, std::filesystem::path> shards{};
+    std::vector<std::filesystem::path> shard_files{};
+    if (sharding)
+    {
+      if (output_source.extension() != ".cpp" && output_source.extension() != ".c")
+        throw std::runtime_error("Sharded embedding requires the second output to be a source file.");
+      for (const auto &resource : resources)
+      {
+        if (accept_function && !accept_function(resource)) continue;
+        const auto shard{path(output_source.parent_path() / (output_source.stem().string() + "_" +
+                                                             resource_name(resource) +
+                                                             output_source.extension().string()))};
+        shards[path(resource)] = shard;
+        shard_files.push_back(shard);
+      }
+    }
+    // Unchanged outputs and shards keep their time, so when the task last ran is recorded by a stamp instead.
+    const auto stamp{utility::task_stamp({output_header, output_source})};
+    std::error_code stamp_error{};
+    const auto stamp_time{std::filesystem::last_write_time(stamp, stamp_error)};
+
+    // The shards of the last run are recorded next to the stamp, so that those of removed resources are deleted.
+    auto shard_record{stamp};
+    shard_record += ".shards";
+    if (std::filesystem::exists(shard_record))
+      for (const auto &line : read_file<std::vector<std::string>>(shard_record))
+        if (const auto shard{path(line)}; !line.empty() && !contains(shard_files, shard))
+        {
+          std::filesystem::remove(shard);
+          std::erase(source_files, shard);
+        }
+    std::vector<std::string> shard_names{};
+    for (const auto &shard : shard_files) shard_names.push_back(shard.string());
+    if (shard_files.empty())
+      std::filesystem::remove(shard_record);
+    else
+      update_file(shard_record, shard_names);
 
-    auto checks = std::vector<std::filesystem::path>{output_header, output_source};
-    checks.reserve(check_files.size() + 2);
+    // A shard is out of date when it is missing or its resource or the build script changed since the last run.
+    auto shard_modified{[&](const std::filesystem::path &resource)
+                        {
+                          return stamp_error || !std::filesystem::exists(shards.at(resource)) ||
+                                 std::filesystem::last_write_time(resource) > stamp_time ||
+                                 utility::build_script_time() > stamp_time;
+                        }};
+
+    auto checks = std::vector<std::filesystem::path>{stamp};
+    checks.reserve(check_files.size() + 1);
     for (const auto &file : check_files) checks.push_back(file);
     task_run(
-      [&](const std::vector<std::filesystem::path> &task_resources,
-          const std::vector<std::filesystem::path> &task_outputs)
+      [&](const std::vector<std::filesystem::path> &task_resources, const std::vector<std::filesystem::path> &)
       {
-        if (task_outputs.size() < 2) throw std::runtime_error("You must define a header and source output file.");
-        const std::pair<std::filesystem::path, std::filesystem::path> fixed_outputs = {task_outputs.at(0),
-                                                                                       task_outputs.at(1)};
+        const std::pair<std::filesystem::path, std::filesystem::path> fixed_outputs = {path(output_header),
+                                                                                       path(output_source)};
         print<COUT>("Generating embedded resources into '{}' and '{}'... ", fixed_outputs.first.string(),
                     fixed_outputs.second.string());
 
-        auto header_content{header_start_content};
-        auto source_content{source_start_content};
+        auto is_header{[](const std::filesystem::path &output)
+                       { return output.extension() == ".hpp" || output.extension() == ".h"; }};
+        for (const auto &output : {fixed_outputs.first, fixed_outputs.second})
+          if (!is_header(output) && output.extension() != ".cpp" && output.extension() != ".c")
+            throw std::runtime_error(std::format("Embed output file has unsupported extension: {}.", output.string()));
+        utility::streamed_file first_output{fixed_outputs.first};
+        utility::streamed_file second_output{fixed_outputs.second};
+        const bool first_header{is_header(fixed_outputs.first)};
+        const bool second_header{is_header(fixed_outputs.second)};
+        const std::function<void(std::string_view)> write_header{[&](const std::string_view text)
+                                                                 {
+                                                                   if (first_header) first_output.write(text);
+                                                                   if (second_header) second_output.write(text);
+                                                                 }};
+        const std::function<void(std::string_view)> write_source{[&](const std::string_view text)
+                                                                 {
+                                                                   if (!first_header) first_output.write(text);
+                                                                   if (!second_header) second_output.write(text);
+                                                                 }};
+        write_header(header_start_content);
+        write_source(source_start_content);
+
+        // Everything that concerns a single resource is gathered first, in parallel when the functions allow it, and
+        // then written out in the order the resources were given in.
+        struct loaded
+        {
+          std::filesystem::path resource{};
+          std::string name{};
+          tuple data{};
+          std::string header{};
+          std::string source{};
+          std::exception_ptr error{};
+        };
+        std::vector<loaded> loads{};
+        for (const auto &resource : task_resources)
+          if (!accept_function || accept_function(resource)) loads.push_back({.resource = resource});
+        auto load{[&](loaded &item)
+                  {
+                    try
+                    {
+                      const auto &resource{item.resource};
+                      if (!std::filesystem::exists(resource) || !std::filesystem::is_regular_file(resource))
+                        throw std::runtime_error("Resource file does not exist or is not a regular file: " +
+                                                 resource.string() + ".");
+
+                      if (data_retrieval_function)
+                        item.data = data_retrieval_function(resource);
+                      else
+                      {
+                        std::vector<std::byte> &data_vector{std::get<0>(item.data)};
+                        data_vector = read_file<std::vector<std::byte>>(resource);
+                      }
+
+                      item.name = resource_name(resource);
+                      if (header_function) item.header = header_function(resource, item.name, item.data);
+                      if (source_function && !sharding)
+                        item.source = source_function(resource, item.name, item.data);
+                      else if (sharding && shard_modified(resource))
+                      {
+                        utility::streamed_file shard_output{shards.at(resource)};
+                        shard_output.write(source_start_content);
+                        substitute_file_data(source_function(resource, item.name, item.data), item.name, item.data,
+                                             data_format_function,
+                                             [&](const std::string_view text) { shard_output.write(text); });
+                        shard_output.commit();
+                      }
+                    }
+                    catch (...)
+                    {
+                      item.error = std::current_exception();
+                    }
+                  }};
+        if (parallel)
+          std::for_each(std::execution::par, loads.begin(), loads.end(), load);
+        else
+          std::ranges::for_each(loads, load);
 
         std::vector<std::tuple<std::filesystem::path, std::string, tuple>> files{};
+        files.reserve(loads.size());
+        for (auto &item : loads)
+        {
+          if (item.error) std::rethrow_exception(item.error);
+          if (header_function)
+            substitute_file_data(std::move(item.header), item.name, item.data, data_format_function, write_header);
+          if (source_function && !sharding)
+            substitute_file_data(std::move(item.source), item.name, item.data, data_format_function, write_source);
+          files.emplace_back(std::move(item.resource), std::move(item.name), std::move(item.data));
+        }
+        if (header_end_function) write_header(header_end_function(files));
+        if (source_end_function) write_source(source_end_function(files));
+        first_output.commit();
+        second_output.commit();
+        touch(stamp);
+
+        print<COUT>("done.\n");
+        return std::string();
+      },
+      resources, checks,
+      [&](const std::filesystem::path &resource, const std::vector<std::filesystem::path> &)
+      { return sharding && shards.contains(resource) && shard_modified(resource); });
+    for (const auto &shard : shard_files)
+      if (!contains(source_files, shard)) source_files.push_back(shard);
+  }
+
+  namespace utility
+  {
+    // Appends an unsigned integer to a byte string in little endian order, as object files store them.
+    template <std::unsigned_integral type> inline void append_integer(std::string &bytes, const type value)
+    {
+      for (std::size_t index{}; index < sizeof(type); ++index)
+        bytes += static_cast<char>((value >> (index * 8)) & 0xFFu);
+    }
+
+    /**
+     * Lays out a relocatable object for the host platform that defines one read-only data symbol per entry. Returns
+     * the bytes that come before the data, the offset of each symbol's data from the start of the data and the bytes
+     * that come after it; the data itself is left to the caller so that it can be streamed into the object. Only 64 bit
+     * x64 and arm64 hosts are supported.
+     */
+    inline std::tuple<std::string, std::vector<std::uint64_t>, std::string>
+    object_layout(const std::vector<std::pair<std::string, std::uint64_t>> &symbols)
+    {
+      if (host_architecture != "x64" && host_architecture != "arm64")
+        throw std::runtime_error(std::format("Embedded objects are not supported on {} hosts.", host_architecture));
+      auto align{[](const std::uint64_t value, const std::uint64_t alignment)
+                 { return (value + alignment - 1) / alignment * alignment; }};
+      std::vector<std::uint64_t> offsets{};
+      std::uint64_t data_size{};
+      for (const auto &symbol : symbols)
+      {
+        data_size = align(data_size, 16);
+        offsets.push_back(data_size);
+        data_size += symbol.second;
+      }
+
+      std::string head{};
+      std::string tail{};
+      if (host_platform == WINDOWS)
+      {
+        if (data_size > std::numeric_limits<std::uint32_t>::max())
+          throw std::runtime_error("Embedded resources are too large for a single object file.");
+        const std::uint32_t header_size{20 + 40};
+        append_integer<std::uint16_t>(head, host_architecture == "arm64" ? 0xAA64 : 0x8664);
+        append_integer<std::uint16_t>(head, 1);
+        append_integer<std::uint32_t>(head, 0);
+        append_integer<std::uint32_t>(head, header_size + static_cast<std::uint32_t>(data_size));
+        append_integer<std::uint32_t>(head, static_cast<std::uint32_t>(symbols.size()));
+        append_integer<std::uint16_t>(head, 0);
+        append_integer<std::uint16_t>(head, 0);
+        head += std::string_view{".rdata\0\0", 8};
+        append_integer<std::uint32_t>(head, 0);
+        append_integer<std::uint32_t>(head, 0);
+        append_integer<std::uint32_t>(head, static_cast<std::uint32_t>(data_size));
+        append_integer<std::uint32_t>(head, data_size == 0 ? 0 : header_size);
+        append_integer<std::uint32_t>(head, 0);
+        append_integer<std::uint32_t>(head, 0);
+        append_integer<std::uint16_t>(head, 0);
+        append_integer<std::uint16_t>(head, 0);
+        append_integer<std::uint32_t>(head, 0x40500040);
+
+        std::string strings{};
+        for (std::size_t index{}; index < symbols.size(); ++index)
+        {
+          const auto &name{symbols[index].first};
+          if (name.size() <= 8)
+            tail += name + std::string(8 - name.size(), '\0');
+          else
+          {
+            append_integer<std::uint32_t>(tail, 0);
+            append_integer<std::uint32_t>(tail, static_cast<std::uint32_t>(4 + strings.size()));
+            strings += name + '\0';
+          }
+          append_integer<std::uint32_t>(tail, static_cast<std::uint32_t>(offsets[index]));
+          append_integer<std::uint16_t>(tail, 1);
+          append_integer<std::uint16_t>(tail, 0);
+          append_integer<std::uint8_t>(tail, 2);
+          append_integer<std::uint8_t>(tail, 0);
+        }
+        append_integer<std::uint32_t>(tail, static_cast<std::uint32_t>(4 + strings.size()));
+        tail += strings;
+        return {head, offsets, tail};
+      }
+
+      const std::uint64_t data_offset{64};
+      std::uint64_t position{data_offset + data_size};
+      auto pad{[&](const std::uint64_t alignment)
+               {
+                 const auto aligned{align(position, alignment)};
+                 tail += std::string(aligned - position, '\0');
+                 position = aligned;
+               }};
+      auto append{[&](const std::string &bytes)
+                  {
+                    tail += bytes;
+                    position += bytes.size();
+                  }};
+
+      std::string symbol_table(24, '\0');
+      std::string symbol_names(1, '\0');
+      for (std::size_t index{}; index < symbols.size(); ++index)
+      {
+        append_integer<std::uint32_t>(symbol_table, static_cast<std::uint32_t>(symbol_names.size()));
+        append_integer<std::uint8_t>(symbol_table, 0x11);
+        append_integer<std::uint8_t>(symbol_table, 0);
+        append_integer<std::uint16_t>(symbol_table, 1);
+        append_integer<std::uint64_t>(symbol_table, offsets[index]);
+        append_integer<std::uint64_t>(symbol_table, symbols[index].second);
+        symbol_names += symbols[index].first + '\0';
+      }
+      std::string section_names(1, '\0');
+      auto section_name{[&](const std::string_view name)
+                        {
+                          const auto offset{static_cast<std::uint32_t>(section_names.size())};
+                          section_names += name;
+                          section_names += '\0';
+                          return offset;
+                        }};
+      const auto data_name{section_name(".rodata")};
+      const auto stack_name{section_name(".note.GNU-stack")};
+      const auto symbol_table_name{section_name(".symtab")};
+      const auto symbol_names_name{section_name(".strtab")};
+      const auto section_names_name{section_name(".shstrtab")};
+
+      pad(8);
+      const auto symbol_table_offset{position};
+      append(symbol_table);
+      const auto symbol_names_offset{position};
+      append(symbol_names);
+      const auto section_names_offset{position};
+      append(section_names);
+      pad(8);
+      const auto section_headers_offset{position};
+
+      std::string section_headers(64, '\0');
+      auto section{[&](const std::uint32_t name, const std::uint32_t type, const std::uint64_t flags,
+                       const std::uint64_t offset, const std::uint64_t size, const std::uint32_t link,
+                       const std::uint32_t info, const std::uint64_t alignment, const std::uint64_t entry_size)
+                   {
+                     append_integer<std::uint32_t>(section_headers, name);
+                     append_integer<std::uint32_t>(section_headers, type);
+                     append_integer<std::uint64_t>(section_headers, flags);
+                     append_integer<std::uint64_t>(section_headers, 0);
+                     append_integer<std::uint64_t>(section_headers, offset);
+                     append_integer<std::uint64_t>(section_headers, size);
+                     append_integer<std::uint32_t>(section_headers, link);
+                     append_integer<std::uint32_t>(section_headers, info);
+                     append_integer<std::uint64_t>(section_headers, alignment);
+                     append_integer<std::uint64_t>(section_headers, entry_size);
+                   }};
+      section(data_name, 1, 2, data_offset, data_size, 0, 0, 16, 0);
+      section(stack_name, 1, 0, symbol_table_offset, 0, 0, 0, 1, 0);
+      section(symbol_table_name, 2, 0, symbol_table_offset, symbol_table.size(), 4, 1, 8, 24);
+      section(symbol_names_name, 3, 0, symbol_names_offset, symbol_names.size(), 0, 0, 1, 0);
+      section(section_names_name, 3, 0, section_names_offset, section_names.size(), 0, 0, 1, 0);
+      append(section_headers);
+
+      head += std::string_view{"\x7F" "ELF\x02\x01\x01\0\0\0\0\0\0\0\0\0", 16};
+      append_integer<std::uint16_t>(head, 1);
+      append_integer<std::uint16_t>(head, host_architecture == "arm64" ? 183 : 62);
+      append_integer<std::uint32_t>(head, 1);
+      append_integer<std::uint64_t>(head, 0);
+      append_integer<std::uint64_t>(head, 0);
+      append_integer<std::uint64_t>(head, section_headers_offset);
+      append_integer<std::uint32_t>(head, 0);
+      append_integer<std::uint16_t>(head, 64);
+      append_integer<std::uint16_t>(head, 0);
+      append_integer<std::uint16_t>(head, 0);
+      append_integer<std::uint16_t>(head, 64);
+      append_integer<std::uint16_t>(head, 6);
+      append_integer<std::uint16_t>(head, 5);
+      return {head, offsets, tail};
+    }
+
+    // Writes a relocatable object defining one read-only data symbol per entry, streaming each entry's bytes into it.
+    inline void write_object(const std::filesystem::path &file,
+                             const std::vector<std::pair<std::string, std::span<const std::byte>>> &symbols)
+    {
+      std::vector<std::pair<std::string, std::uint64_t>> sizes{};
+      for (const auto &[name, data] : symbols) sizes.emplace_back(name, data.size());
+      const auto [head, offsets, tail]{object_layout(sizes)};
+
+      if (file.has_parent_path()) std::filesystem::create_directories(file.parent_path());
+      const auto temporary{temporary_file(file)};
+      {
+        std::ofstream output_file(temporary, std::ios::binary | std::ios::trunc);
+        if (!output_file.is_open()) throw std::runtime_error("Failed to open file: " + file.string());
+        output_file.write(head.data(), static_cast<std::streamsize>(head.size()));
+        std::uint64_t position{};
+        for (std::size_t index{}; index < symbols.size(); ++index)
+        {
+          const std::string padding(offsets[index] - position, '\0');
+          const auto &data{symbols[index].second};
+          output_file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+          output_file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+          position = offsets[index] + data.size();
+        }
+        output_file.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+        if (!output_file.flush())
+        {
+          output_file.close();
+          std::filesystem::remove(temporary);
+          throw std::runtime_error("Failed to write file: " + file.string());
+        }
+      }
+      std::filesystem::rename(temporary, file);
+    }
+  }
+
+  namespace utility
+  {
+    /**
+     * Compresses bytes into a sequence of LZ77 matches that `decompressor_source` decodes: each sequence is a token
+     * holding a literal length and a match length in its two halves, extended by further bytes when they reach 15,
+     * followed by the literals and a two byte offset back to the match. The last sequence only has literals. Inputs
+     * must be smaller than 4 GiB.
+     */
+    inline std::vector<std::byte> compress_bytes(const std::span<const std::byte> input)
+    {
+      constexpr std::size_t minimum_match{4};
+      constexpr std::size_t window{65535};
+      std::vector<std::byte> output{};
+      output.reserve(input.size() / 2);
+      std::vector<std::uint32_t> table(std::size_t{1} << 16);
+      auto read{[&](const std::size_t position)
+                {
+                  std::uint32_t value{};
+                  std::memcpy(&value, input.data() + position, sizeof(value));
+                  return value;
+                }};
+      auto put_length{[&](std::size_t value)
+                      {
+                        for (; value >= 255; value -= 255) output.push_back(std::byte{255});
+                        output.push_back(static_cast<std::byte>(value));
+                      }};
+      auto sequence{[&](const std::size_t anchor, const std::size_t position, const std::size_t offset,
+                        const std::size_t match)
+                    {
+                      const std::size_t literals{position - anchor};
+                      const std::size_t extra{match == 0 ? 0 : match - minimum_match};
+                      output.push_back(static_cast<std::byte>((std::min<std::size_t>(literals, 15) << 4) |
+                                                              std::min<std::size_t>(extra, 15)));
+                      if (literals >= 15) put_length(literals - 15);
+                      output.insert(output.end(), input.begin() + static_cast<std::ptrdiff_t>(anchor),
+                                    input.begin() + static_cast<std::ptrdiff_t>(position));
+                      if (match == 0) return;
+                      output.push_back(static_cast<std::byte>(offset & 0xFF));
+                      output.push_back(static_cast<std::byte>(offset >> 8));
+                      if (extra >= 15) put_length(extra - 15);
+                    }};
+
+      std::size_t anchor{};
+      std::size_t position{};
+      while (position + minimum_match <= input.size())
+      {
+        const auto value{read(position)};
+        // Entries hold the position after the last one with the same hash, so that zero means there is none.
+        auto &entry{table[(value * 2654435761u) >> 16]};
+        const std::size_t candidate{entry};
+        entry = static_cast<std::uint32_t>(position + 1);
+        if (candidate == 0 || position + 1 - candidate > window || read(candidate - 1) != value)
+        {
+          // Steps grow the longer nothing matches, so incompressible data is skipped over quickly.
+          position += 1 + ((position - anchor) >> 6);
+          continue;
+        }
+        std::size_t match{minimum_match};
+        while (position + match < input.size() && input[candidate - 1 + match] == input[position + match]) ++match;
+        sequence(anchor, position, position + 1 - candidate, match);
+        position += match;
+        anchor = position;
+      }
+      sequence(anchor, input.size(), 0, 0);
+      return output;
+    }
+
+    // The decoder for `compress_bytes` that generated headers carry, which keeps each decoded resource for good.
+    inline constexpr std::string_view decompressor_source{R"(#ifndef CSB_EMBED_DECOMPRESS
+#define CSB_EMBED_DECOMPRESS
+namespace csb_embed
+{
+  inline const unsigned char *decompress(const unsigned char *source, const std::size_t size,
+                                         const std::size_t original)
+  {
+    unsigned char *output{new unsigned char[original == 0 ? 1 : original]};
+    std::size_t in{};
+    std::size_t out{};
+    const auto length{[&](std::size_t value)
+                      {
+                        if (value == 15)
+                          for (unsigned char byte{255}; byte == 255; value += byte) byte = source[in++];
+                        return value;
+                      }};
+    while (in < size)
+    {
+      const std::size_t token{source[in++]};
+      const std::size_t literals{length(token >> 4)};
+      for (std::size_t index{}; index < literals; ++index) output[out++] = source[in++];
+      if (in >= size) break;
+      const std::size_t offset{static_cast<std::size_t>(source[in]) | (static_cast<std::size_t>(source[in + 1]) << 8)};
+      in += 2;
+      for (std::size_t match{length(token & 15) + 4}; match > 0; --match, ++out) output[out] = output[out - offset];
+    }
+    return output;
+  }
+}
+#endif
+)"};
+  }
+
+  /**
+   * Embeds given resource files straight into an object file that is linked into the target, along with a header that
+   * declares them, without generating any source code for the compiler to parse.
+   *
+   * Each resource is accessible through `const unsigned char *name_data()` and its size through
+   * `constexpr std::size_t name_size`, both declared in the generated header. Uncompressed resources are also directly
+   * accessible through `extern "C" const unsigned char name[]`, aligned to 16 bytes, which `name_data` returns;
+   * compressed resources are decompressed into a buffer the first time `name_data` is called, which is kept for the
+   * rest of the program and shared by later calls, from any thread. The object is added to
+   * `object_files` so that `link` picks it up; targets given to the multi-target `link` need it listed in their own
+   * `object_files`. The object is only rewritten when a resource changes, and the header only when a name, a size or
+   * whether a resource is compressed does; the compressed size lives in the object as `name_compressed_size`.
+   *
+   * This function's parameters behave as follows:
+   * | `name_retrieval_function`: A function that takes a file and returns its symbol name, which must be a valid C
+   *                              identifier; by default, it just takes the filename and replace "." and "-" with "_".
+   * | `accept_function`: A function that takes a file and returns true if it should be embedded; by default, all files
+   *                      are embedded.
+   * | `resources`: A list of resource files to embed.
+   * | `outputs`: A pair of output paths specifying where to write the generated header and object files respectively;
+   *              the object should use ".obj" on Windows and ".o" on Linux.
+   * | `check_files`: A list of files that will trigger a re-run of the function if missing or changed.
+   * | `compression_ratio`: The largest compressed size, as a fraction of the original size, for which a resource is
+   *                        stored compressed; resources that compress worse stay raw, and the default of 0 stores
+   *                        every resource raw.
+   * | `compression_minimum`: The size in bytes below which resources stay raw, as decompressing them would cost more
+   *                          than the space it saves.
+   *
+   * See also: `embed`, `link`.
+   */
+  inline void embed_object(const std::function<std::string(const std::filesystem::path &)> &name_retrieval_function,
+                           const std::function<bool(const std::filesystem::path &)> &accept_function,
+                           const std::vector<std::filesystem::path> &resources,
+                           const std::pair<std::filesystem::path, std::filesystem::path> &outputs,
+                           const std::vector<std::filesystem::path> &check_files, const double compression_ratio = 0.0,
+                           const std::uint64_t compression_minimum = 4096)
+  {
+    if (resources.empty()) throw std::runtime_error("No resources to embed.");
+    if (outputs.first.empty() || outputs.second.empty()) throw std::runtime_error("Embed output files not set.");
+    const auto output_header{path(outputs.first)};
+    const auto output_object{path(outputs.second)};
+
+    // The object is the only output whose time is checked, since the header keeps its time while it does not change.
+    if (!std::filesystem::exists(output_header)) std::filesystem::remove(output_object);
+    auto checks = std::vector<std::filesystem::path>{output_object};
+    checks.reserve(check_files.size() + 1);
+    for (const auto &file : check_files) checks.push_back(file);
+    task_run(
+      [&](const std::vector<std::filesystem::path> &task_resources, const std::vector<std::filesystem::path> &)
+      {
+        print<COUT>("Embedding resources into '{}' and '{}'... ", output_header.string(), output_object.string());
+
+        std::vector<std::pair<std::string, mapped_file>> symbols{};
         for (const auto &resource : task_resources)
         {
           if (accept_function && !accept_function(resource)) continue;
@@ -30900,15 +33296,6 @@ namespace csb
             throw std::runtime_error("Resource file does not exist or is not a regular file: " + resource.string() +
                                      ".");
 
-          tuple data{};
-          if (data_retrieval_function)
-            data = data_retrieval_function(resource);
-          else
-          {
-            std::vector<std::byte> &data_vector{std::get<0>(data)};
-            data_vector = read_file<std::vector<std::byte>>(resource);
-          }
-
           std::string name{};
           if (name_retrieval_function)
             name = name_retrieval_function(resource);
@@ -30918,54 +33305,78 @@ namespace csb
             std::ranges::replace(name, '.', '_');
             std::ranges::replace(name, '-', '_');
           }
-          if (header_function)
-            header_content +=
-              substitute_file_data(header_function(resource, name, data), name, data, data_format_function);
-          if (source_function)
-            source_content +=
-              substitute_file_data(source_function(resource, name, data), name, data, data_format_function);
-          files.push_back(std::make_tuple(resource, name, data));
-        }
-        if (header_end_function) header_content += header_end_function(files);
-        if (source_end_function) source_content += source_end_function(files);
-
-        {
-          if (fixed_outputs.first.has_parent_path())
-            std::filesystem::create_directories(fixed_outputs.first.parent_path());
-          std::ofstream output_file(fixed_outputs.first);
-          if (!output_file.is_open())
-            throw std::runtime_error(
-              std::format("Failed to open embed output file for writing: {}.", fixed_outputs.first.string()));
-          if (fixed_outputs.first.extension() == ".hpp" || fixed_outputs.first.extension() == ".h")
-            output_file << header_content;
-          else if (fixed_outputs.first.extension() == ".cpp" || fixed_outputs.first.extension() == ".c")
-            output_file << source_content;
-          else
-            throw std::runtime_error(
-              std::format("Embed output file has unsupported extension: {}.", fixed_outputs.first.string()));
-          output_file.close();
-        }
-        {
-          if (fixed_outputs.second.has_parent_path())
-            std::filesystem::create_directories(fixed_outputs.second.parent_path());
-          std::ofstream output_file(fixed_outputs.second);
-          if (!output_file.is_open())
+          if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front())) ||
+              !std::ranges::all_of(name, [](const unsigned char character)
+                                   { return std::isalnum(character) || character == '_'; }))
             throw std::runtime_error(
-              std::format("Failed to open embed output file for writing: {}.", fixed_outputs.second.string()));
-          if (fixed_outputs.second.extension() == ".hpp" || fixed_outputs.second.extension() == ".h")
-            output_file << header_content;
-          else if (fixed_outputs.second.extension() == ".cpp" || fixed_outputs.second.extension() == ".c")
-            output_file << source_content;
-          else
+              std::format("Invalid embedded symbol name '{}' for: {}.", name, resource.string()));
+          if (std::ranges::any_of(symbols, [&](const auto &symbol) { return symbol.first == name; }))
             throw std::runtime_error(
-              std::format("Embed output file has unsupported extension: {}.", fixed_outputs.second.string()));
-          output_file.close();
+              std::format("Duplicate embedded symbol name '{}' for: {}.", name, resource.string()));
+
+          symbols.emplace_back(name, mapped_file{resource});
         }
 
+        std::vector<std::optional<std::vector<std::byte>>> compressed(symbols.size());
+        std::transform(std::execution::par, symbols.begin(), symbols.end(), compressed.begin(),
+                       [&](const std::pair<std::string, mapped_file> &symbol) -> std::optional<std::vector<std::byte>>
+                       {
+                         const auto size{symbol.second.size()};
+                         if (compression_ratio <= 0.0 || size < compression_minimum ||
+                             size >= std::numeric_limits<std::uint32_t>::max())
+                           return std::nullopt;
+                         auto bytes{utility::compress_bytes(symbol.second.bytes())};
+                         if (static_cast<double>(bytes.size()) > compression_ratio * static_cast<double>(size))
+                           return std::nullopt;
+                         return bytes;
+                       });
+
+        std::string declarations{};
+        std::vector<std::pair<std::string, std::span<const std::byte>>> object_symbols{};
+        // Compressed sizes are stored as 64 bit little endian values and declared as std::uint64_t on every host.
+        std::vector<std::array<std::byte, 8>> compressed_sizes{};
+        compressed_sizes.reserve(symbols.size());
+        for (std::size_t index{}; index < symbols.size(); ++index)
+        {
+          const auto &[name, data]{symbols[index]};
+          declarations += std::format("\ninline constexpr std::size_t {}_size{{{}}};\n", name, data.size());
+          if (!compressed[index])
+          {
+            declarations += std::format("extern \"C\" const unsigned char {}[];\n"
+                                        "inline const unsigned char *{}_data() {{ return {}; }}\n",
+                                        name, name, name);
+            object_symbols.emplace_back(name, data.bytes());
+            continue;
+          }
+          declarations += std::format("extern \"C\" const unsigned char {}_compressed[];\n"
+                                      "extern \"C\" const std::uint64_t {}_compressed_size;\n"
+                                      "inline const unsigned char *{}_data()\n"
+                                      "{{\n"
+                                      "  static const unsigned char *const data{{\n"
+                                      "    csb_embed::decompress({}_compressed,\n"
+                                      "                          static_cast<std::size_t>({}_compressed_size),\n"
+                                      "                          {}_size)}};\n"
+                                      "  return data;\n"
+                                      "}}\n",
+                                      name, name, name, name, name, name);
+          auto &size_bytes{compressed_sizes.emplace_back()};
+          for (std::size_t byte{}; byte < size_bytes.size(); ++byte)
+            size_bytes[byte] = static_cast<std::byte>((compressed[index]->size() >> (byte * 8)) & 0xFFu);
+          object_symbols.emplace_back(name + "_compressed", *compressed[index]);
+          object_symbols.emplace_back(name + "_compressed_size", size_bytes);
+        }
+        const bool any_compressed{std::ranges::any_of(compressed, [](const auto &bytes) { return bytes.has_value(); })};
+        const auto header_content{std::format("#pragma once\n\n#include <cstddef>\n#include <cstdint>\n\n{}{}",
+                                              any_compressed ? utility::decompressor_source : "", declarations)};
+
+        utility::write_object(output_object, object_symbols);
+        update_file(output_header, header_content);
+
         print<COUT>("done.\n");
         return std::string();
       },
       resources, checks);
+    if (!contains(object_files, output_object)) object_files.push_back(output_object);
   }
 
   /**
@@ -30974,9 +33385,10 @@ namespace csb
    * CSData (csd.hpp).
    *
    * Texture and font resources must be aseprite files; sound and music resources are embedded as raw audio data. Pack
-   * files are written to "build/debug" or "build/release" depending on the target configuration, and stale csp files
-   * found there are removed. The generated header declares each resource inside the given namespace and the generated
-   * source defines them against the pack files, which are resolved relative to the executable at run time.
+   * files are written to the build directory of the target configuration, and stale csp files found there are removed.
+   * Debug strings are only packed for configurations using the debug runtime. The generated header declares each
+   * resource inside the given namespace and the generated source defines them against the pack files, which are
+   * resolved relative to the executable at run time.
    *
    * Sound and music files authored in Reaper carry their project source inside the rendered audio itself, so only the
    * audio file needs to exist in version control. On every pack, an audio file whose sibling .rpp file (same path with
@@ -30993,7 +33405,7 @@ namespace csb
    * | `sounds`: A list of audio files that will be accessible as sounds.
    * | `musics`: A list of audio files that will be accessible as music.
    * | `pack`: A function that takes a resource file and returns the name of the csp file it belongs to, without the
-   *           extension; for example, returning "CSGame" places the file in "build/[debug|release]/CSGame.csp" and
+   *           extension; for example, returning "CSGame" places the file in "build/[configuration]/CSGame.csp" and
    *           mounts it as "CSGame.csp" at run time.
    * | `space`: The namespace that the generated resource accessors will be placed in.
    * | `outputs`: A pair of output paths specifying where to write the generated header and source files respectively.
@@ -31040,20 +33452,27 @@ namespace csb
     filter(musics, "music", csd::packable_audio);
     if (resources.empty()) throw std::runtime_error("No resources to pack.");
 
+    // Audio is mapped once here and the same view is loaded from below, unless syncing the project rewrote it.
+    std::unordered_map<std::filesystem::path, mapped_file> audio_views{};
     for (const auto &file : resources)
     {
       if (spaces.at(file) != "sound" && spaces.at(file) != "music") continue;
       auto project{file};
       project.replace_extension(".rpp");
-      const auto audio{read_file<std::vector<std::byte>>(file)};
-      const auto embedded{csd::audio_extract_rpp(audio, file)};
+      auto audio{read_file<mapped_file>(file)};
+      const auto embedded{csd::audio_extract_rpp(audio.bytes(), file)};
       if (std::filesystem::exists(project))
       {
         const auto source{read_file<std::vector<std::byte>>(project)};
-        if (!embedded || *embedded != source) write_file(file, csd::audio_replace_rpp(audio, source, file));
+        if (!embedded || *embedded != source)
+        {
+          write_file(file, csd::audio_replace_rpp(audio.bytes(), source, file));
+          continue;
+        }
       }
       else if (embedded)
         write_file(project, *embedded);
+      audio_views.emplace(file, std::move(audio));
     }
 
     std::unordered_map<std::filesystem::path, std::string> packs_of{};
@@ -31063,13 +33482,10 @@ namespace csb
       if (name.empty()) throw std::runtime_error("Pack name is empty for resource: " + file.string() + ".");
       packs_of.emplace(file, name);
     }
-    const auto pack_directory{path("build") / (target_configuration == RELEASE ? "release" : "debug")};
-    std::vector<std::filesystem::path> pack_files{};
-    for (const auto &file : resources)
-    {
-      const auto pack_file{pack_directory / (packs_of.at(file) + ".csp")};
-      if (!contains(pack_files, pack_file)) pack_files.push_back(pack_file);
-    }
+    const auto pack_directory{configuration_directory().make_preferred()};
+    utility::path_set pack_set{};
+    for (const auto &file : resources) pack_set.insert(pack_directory / (packs_of.at(file) + ".csp"));
+    const auto &pack_files{pack_set.paths};
 
     const auto manifest{path("build") / "resource" / "pack.manifest"};
     std::vector<std::filesystem::path> manifest_files{resources};
@@ -31088,10 +33504,12 @@ namespace csb
                 {{},
                  {},
                  [](const std::filesystem::path &file) -> std::string { return file.stem().string(); },
-                 [&spaces, &packs_of](const std::filesystem::path &file) -> data
+                 [&spaces, &packs_of, &audio_views](const std::filesystem::path &file) -> data
                  {
-                   return data{std::vector<std::byte>{},
-                               csd::load(file, file.stem().string(), spaces.at(file), packs_of.at(file))};
+                   const auto found{audio_views.find(file)};
+                   const auto view{found != audio_views.end() ? std::move(found->second) : mapped_file{file}};
+                   return data{std::vector<std::byte>{}, csd::load(file, file.stem().string(), spaces.at(file),
+                                                                   packs_of.at(file), view.bytes())};
                  },
                  {}},
                 {[&](const std::vector<std::tuple<std::filesystem::path, std::string, data>> &files) -> std::string
@@ -31103,7 +33521,7 @@ namespace csb
                  },
                  [&](const std::vector<std::tuple<std::filesystem::path, std::string, data>> &files) -> std::string
                  {
-                   const bool debug{target_configuration == DEBUG};
+                   const bool debug{target_configuration.runtime_library == DEBUG_RUNTIME};
                    std::vector<const csd::resource *> list{};
                    list.reserve(files.size());
                    for (const auto &[file, name, value] : files) list.push_back(&std::get<1>(value));
@@ -31136,7 +33554,7 @@ namespace csb
                        container.append(layout.strings);
                        binding.strings = container.table.at(strings_entry).first;
                      }
-                     write_file(pack_directory / (layout.pack + ".csp"), container);
+                     update_file(pack_directory / (layout.pack + ".csp"), container);
                      binding.signature = container.signature();
                      binding.hitboxes = {container.table.at(hitboxes_entry).first,
                                          container.table.at(hitboxes_entry).second};
@@ -31146,12 +33564,12 @@ namespace csb
                    }
                    return csd::accessor_source(list, space, layouts, bindings, debug);
                  }},
-                {}, resources, outputs, pack_files);
+                {}, resources, outputs, pack_files, false, true);
 
     if (std::filesystem::exists(pack_directory))
       for (const auto &file : choose_files({pack_directory}, [](const std::filesystem::path &entry)
                                            { return entry.extension() == ".csp"; }))
-        if (!contains(pack_files, file)) csb::remove(file);
+        if (!pack_set.contains(file)) csb::remove(file);
   }
 
   /**
@@ -31167,7 +33585,9 @@ namespace csb
     target_files.reserve(source_files.size() + include_files.size());
     target_files.insert(target_files.end(), source_files.begin(), source_files.end());
     target_files.insert(target_files.end(), include_files.begin(), include_files.end());
-    if (utility::find_modified_files(target_files, {"compile_commands.json"}).empty()) return;
+    const auto compile_commands_path{std::filesystem::path{"build"} / "compile_commands.json"};
+    const auto stamp{utility::task_stamp({compile_commands_path})};
+    if (utility::find_modified_files(target_files, {stamp}).empty()) return;
 
     auto escape_backslashes{[](const std::string &string) -> std::string
                             {
@@ -31182,10 +33602,11 @@ namespace csb
                               return result;
                             }};
 
-    auto compile_commands_path{std::filesystem::path{"build"} / "compile_commands.json"};
-    auto build_directory{std::filesystem::path{"build"} / (target_configuration == RELEASE ? "release" : "debug")};
+    auto build_directory{configuration_directory()};
     std::string compile_definitions{host_platform == WINDOWS ? "-D_WIN32 " : "-D__linux__ "};
-    compile_definitions += target_configuration == DEBUG ? "-D_DEBUG" : "-DNDEBUG";
+    compile_definitions += target_configuration.runtime_library == DEBUG_RUNTIME ? "-D_DEBUG" : "-DNDEBUG";
+    for (const auto &definition : target_configuration.definitions)
+      compile_definitions += std::format(" -D{}", definition);
     std::string csb_absolute{
       escape_backslashes(std::filesystem::absolute(std::filesystem::path{"csb"} / "csb.cpp").string())};
     std::string csb_output{escape_backslashes((std::filesystem::path{"build"} / "csb.o").string())};
@@ -31214,12 +33635,10 @@ namespace csb
                              "-Wunreachable-code-aggressive -Wformat=2 {} ",
                              compiler, compile_definitions);
       for (const auto &definition : definitions) content += std::format("-D{} ", definition);
-      std::vector<std::filesystem::path> include_directories{};
+      utility::path_set include_directories{};
       for (const auto &include_file : include_files)
-        if (include_file.has_parent_path() &&
-            std::ranges::find(include_directories, include_file.parent_path()) == include_directories.end())
-          include_directories.push_back(include_file.parent_path());
-      for (const auto &directory : include_directories)
+        if (include_file.has_parent_path()) include_directories.insert(include_file.parent_path());
+      for (const auto &directory : include_directories.paths)
         content += std::format(R"(-I\"{}\" )", escape_backslashes(directory.string()));
       for (const auto &directory : external_include_directories)
         content += std::format(R"(-isystem\"{}\" )", escape_backslashes(directory.string()));
@@ -31233,11 +33652,8 @@ namespace csb
     }
     content += "]\n";
 
-    std::ofstream compile_commands_file(compile_commands_path);
-    if (!compile_commands_file.is_open())
-      throw std::runtime_error("Failed to open compile_commands.json file for writing.");
-    compile_commands_file << content;
-    compile_commands_file.close();
+    update_file(compile_commands_path, content);
+    touch(stamp);
   }
 
   /**
@@ -31252,7 +33668,7 @@ namespace csb
     nlohmann::json config = configuration;
     config.emplace("CompileFlags", nlohmann::json::object());
     config.at("CompileFlags").emplace("CompilationDatabase", "build/");
-    write_file(".clangd", json_to_yaml(config));
+    update_file(".clangd", json_to_yaml(config));
   }
 
   /**
@@ -31267,7 +33683,7 @@ namespace csb
   {
     nlohmann::json config = configuration;
     config.emplace("ExcludeHeaderFilterRegex", ".*");
-    write_file(".clang-tidy", json_to_yaml(config));
+    update_file(".clang-tidy", json_to_yaml(config));
   }
 
   /**
@@ -31326,7 +33742,7 @@ namespace csb
       if (key == "BasedOnStyle" || key == "Language") content += std::string(content.empty() ? "" : "\n") + "---";
       content += std::format("\n{}: {}", key, value);
     }
-    write_file(".clang-format", content + "\n...\n");
+    update_file(".clang-format", content + "\n...\n");
   }
 
   /**
@@ -31402,437 +33818,1341 @@ namespace csb
   // Cleans the specified files.
   inline void clean(const std::filesystem::path &file) { clean(std::vector<std::filesystem::path>{file}); }
 
-  // Compiles the project source files into corresponding object files and selected headers into precompiled headers.
-  inline void compile()
+  namespace utility
   {
-    for (auto &file : source_files) file.make_preferred();
-    for (auto &file : include_files) file.make_preferred();
-    for (auto &file : precompiled_headers) file.make_preferred();
-    for (auto &dir : external_include_directories) dir.make_preferred();
-    for (auto &dir : library_directories) dir.make_preferred();
-
-    if (target_name.empty()) throw std::runtime_error("Executable name not set.");
-    if (source_files.empty()) throw std::runtime_error("No source files to compile.");
+    // A single command that produces outputs from a file.
+    struct job
+    {
+      std::filesystem::path file{};
+      std::vector<std::filesystem::path> outputs{};
+      std::function<std::string()> command{};
+      // Jobs that are run instead when the command fails, used to split up batched compiles.
+      std::vector<job> fallback{};
+      // Runs after the command succeeded.
+      std::function<void()> finish{};
+      // Checked right before the command runs, skipping the job when it returns false.
+      std::function<bool()> modified{};
+    };
 
-    utility::build_directory = std::filesystem::path{"build"} / (target_configuration == RELEASE ? "release" : "debug");
-    if (!std::filesystem::exists(utility::build_directory))
-      std::filesystem::create_directories(utility::build_directory);
+    // Returns a target made from the global target settings.
+    inline target global_target()
+    {
+      return {.name = target_name,
+              .artifact_type = target_artifact,
+              .linkage_type = target_linkage,
+              .subsystem_type = target_subsystem,
+              .source_files = source_files,
+              .include_files = include_files,
+              .precompiled_headers = precompiled_headers,
+              .external_include_directories = external_include_directories,
+              .library_directories = library_directories,
+              .libraries = libraries,
+              .definitions = definitions,
+              .precompiled_header_sources = precompiled_header_sources,
+              .object_files = object_files};
+    }
+
+    // Returns the object directory of a target, which is shared by all targets with identical compile settings.
+    inline std::filesystem::path object_directory(const target &item)
+    {
+      std::string key{std::format("{}|{}|{}|{}|{}|{}|", target_configuration.name, std::to_string(cxx_standard),
+                                  std::to_string(warning_level), item.artifact_type == DYNAMIC_LIBRARY ? "pic" : "",
+                                  item.linkage_type == STATIC ? "static" : "dynamic", unpack(item.definitions))};
+      for (const auto &include_file : item.include_files) key += include_file.parent_path().string() + ";";
+      key += "|" + unpack(item.precompiled_headers) + "|" + unpack(item.external_include_directories) + "|";
+      for (const auto &[header, sources] : item.precompiled_header_sources)
+        key += header.string() + ":" + unpack(sources) + ";";
+      return build_directory / "object" / std::format("{:016x}", csp::signature(key.data(), key.size()));
+    }
+
+    // Returns the path of a file built from a source file, mirroring the source's directory inside the object directory
+    // so that sources sharing a stem never share an object.
+    inline std::filesystem::path object_path(const std::filesystem::path &object_directory,
+                                             const std::filesystem::path &source_file, const std::string &extension)
+    {
+      auto directory{object_directory};
+      for (const auto &part : source_file.lexically_normal().parent_path().relative_path())
+        directory /= part == ".." ? std::filesystem::path{"__"} : part;
+      return directory / (source_file.stem().string() + extension);
+    }
+
+    // Maps every source file of a target to the files built from it, one for each of the given extensions.
+    inline std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>>
+    object_check_files(const target &item, const std::filesystem::path &object_directory,
+                       const std::vector<std::string> &extensions)
+    {
+      std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> check_files{};
+      check_files.reserve(item.source_files.size());
+      for (const auto &source_file : item.source_files)
+      {
+        auto &files{check_files[source_file]};
+        for (const auto &extension : extensions) files.push_back(object_path(object_directory, source_file, extension));
+      }
+      return check_files;
+    }
 
-    if (host_platform == WINDOWS)
+    /**
+     * Runs jobs in parallel, running identical commands only once when several targets share them. Batched jobs are
+     * compared file by file, and a batch that overlaps earlier work is split into the files nobody else builds.
+     * Different commands writing the same output are an error, since one of them would otherwise be silently dropped.
+     */
+    inline void run_jobs(const std::vector<job> &jobs)
     {
-      std::string compile_debug_flags{target_configuration == RELEASE ? "/O2 " : "/Od /Zi /RTC1 "};
-      std::string runtime_library{target_linkage == STATIC ? (target_configuration == RELEASE ? "MT" : "MTd")
-                                                           : (target_configuration == RELEASE ? "MD" : "MDd")};
-      std::string compile_definitions{"/D_WIN32 "};
-      compile_definitions += target_configuration == RELEASE ? "/DNDEBUG " : "/D_DEBUG ";
-      for (const auto &definition : definitions) compile_definitions += std::format("/D{} ", definition);
-      std::vector<std::filesystem::path> include_directories{};
-      for (const auto &include_file : include_files)
-        if (include_file.has_parent_path() &&
-            std::ranges::find(include_directories, include_file.parent_path()) == include_directories.end())
-          include_directories.push_back(include_file.parent_path());
-      for (const auto &header : precompiled_headers)
-        if (header.has_parent_path() &&
-            std::ranges::find(include_directories, header.parent_path()) == include_directories.end())
-          include_directories.push_back(header.parent_path());
-      if (!precompiled_headers.empty())
-        include_directories.insert(include_directories.begin(), utility::build_directory / "pch");
-      std::string compile_include_directories{};
-      for (const auto &directory : include_directories)
-        compile_include_directories += std::format("/I\"{}\" ", directory.string());
-      std::string compile_external_include_directories{};
-      for (const auto &directory : external_include_directories)
-        compile_external_include_directories += std::format("/external:I\"{}\" ", directory.string());
-
-      auto dependency_handler{
-        [](const std::filesystem::path &, const std::vector<std::filesystem::path> &checked_files) -> bool
-        {
-          auto object_time{std::filesystem::last_write_time(checked_files.at(0))};
-          const std::filesystem::path &dependency_path{checked_files.at(1)};
-
-          std::ifstream dependency_file(dependency_path);
-          if (!dependency_file.is_open()) return true;
-          const std::string json_content((std::istreambuf_iterator<char>(dependency_file)),
-                                         std::istreambuf_iterator<char>());
-          dependency_file.close();
-
-          const size_t includes_start{json_content.find("\"Includes\": [")};
-          if (includes_start == std::string::npos) return true;
-          const size_t includes_end{json_content.find(']', includes_start)};
-          if (includes_end == std::string::npos) return true;
-          const std::string includes_section{
-            json_content.substr(includes_start + 13, includes_end - includes_start - 13)};
-          size_t pos{};
-          while ((pos = includes_section.find('\"', pos)) != std::string::npos)
-          {
-            const size_t start{pos + 1};
-            const size_t end{includes_section.find('\"', start)};
-            if (end == std::string::npos) break;
-            const std::filesystem::path include_path{includes_section.substr(start, end - start)};
-            if (std::filesystem::exists(include_path))
-            {
-              auto include_time{std::filesystem::last_write_time(include_path)};
-              if (include_time > object_time) return true;
-            }
-            pos = end + 1;
-          }
-
-          const size_t pch_start{json_content.find(R"("PCH": ")")};
-          if (pch_start == std::string::npos) return false;
-          const size_t pch_end{json_content.find("\",", pch_start)};
-          if (pch_end == std::string::npos) return false;
-          const std::filesystem::path pch_path{json_content.substr(pch_start + 8, pch_end - pch_start - 8)};
-          if (std::filesystem::exists(pch_path))
-          {
-            auto pch_time{std::filesystem::last_write_time(pch_path)};
-            if (pch_time > object_time) return true;
-          }
-
-          return false;
-        }};
+      std::vector<std::pair<const std::filesystem::path, std::vector<std::filesystem::path>>> items{};
+      std::unordered_map<std::filesystem::path, const job *> commands{};
+      std::unordered_map<std::filesystem::path, const job *> producers{};
+      for (const auto &item : jobs)
+      {
+        const std::span<const job> parts{item.fallback.empty() ? std::span<const job>{&item, 1}
+                                                               : std::span<const job>{item.fallback}};
+        std::vector<const job *> unique_parts{};
+        for (const auto &part : parts)
+        {
+          const auto [existing, inserted]{producers.emplace(part.outputs.front(), &part)};
+          if (inserted)
+            unique_parts.push_back(&part);
+          else if (existing->second->command() != part.command())
+            throw std::runtime_error(
+              std::format("Different commands produce the same output: {}.", part.outputs.front().string()));
+        }
+        if (unique_parts.size() == parts.size()) unique_parts = {&item};
+        for (const auto *unique : unique_parts)
+        {
+          commands.emplace(unique->outputs.front(), unique);
+          items.emplace_back(unique->file, unique->outputs);
+        }
+      }
+      if (items.empty()) return;
 
-      auto pch_directory{utility::build_directory / "pch"};
-      if (!precompiled_headers.empty() && !std::filesystem::exists(pch_directory))
-        std::filesystem::create_directories(pch_directory);
-      std::vector<std::filesystem::path> check_files{pch_directory / "(filename.stem)_pch.obj",
-                                                     pch_directory / "(filename.stem)_pch.d",
-                                                     pch_directory / "(filename.stem).pch"};
-      if (target_configuration == DEBUG) check_files.push_back(pch_directory / "(filename.stem)_pch.pdb");
-      multi_task_run(
-        [&](const auto &file, const std::vector<std::filesystem::path> &, const std::vector<std::filesystem::path> &)
-        {
-          std::string relative_path{std::filesystem::relative(file, pch_directory).string()};
-          for (const auto &character : relative_path)
-            if (character == '/') relative_path.replace(relative_path.find(character), 1, "\\");
-          write_file<std::string>(pch_directory / (file.stem().string() + "_pch.cpp"),
-                                  std::format("#include \"{}\"", relative_path));
-
-          std::string compiler{};
-          if (file.extension() == ".h")
-            compiler = "cl /std:c17 /TC";
-          else
-            compiler = "cl /std:c++" + std::to_string(cxx_standard);
-          return std::format("{} /nologo /W{} /WX /external:W0 {}/bigobj /Zc:preprocessor /EHsc /MP /{} "
-                             "{}/ifcOutput{}\\ /Fo{}\\ /Fd\"{}\" "
-                             "/sourceDependencies\"{}\" {}{}/c /Yc\"{}\" /Fp\"{}\" \"{}\"",
-                             compiler, std::to_string(warning_level), compile_debug_flags, runtime_library,
-                             compile_definitions, pch_directory.string(), pch_directory.string(),
-                             (pch_directory / "(stem)_pch.pdb").string(), (pch_directory / "(stem)_pch.d").string(),
-                             compile_include_directories, compile_external_include_directories, relative_path,
-                             (pch_directory / "(stem).pch").string(), (pch_directory / "(stem)_pch.cpp").string());
-        },
-        precompiled_headers, check_files, dependency_handler);
-
-      check_files = {utility::build_directory / "(filename.stem).obj", utility::build_directory / "(filename.stem).d"};
-      if (target_configuration == DEBUG) check_files.push_back(utility::build_directory / "(filename.stem).pdb");
-      multi_task_run(
-        [&](const auto &file, const std::vector<std::filesystem::path> &, const std::vector<std::filesystem::path> &)
-        {
-          std::ifstream read_file(file);
-          if (!read_file.is_open())
-            throw std::runtime_error("Failed to open source file for reading: " + file.string() + ".");
-          std::string first_line{};
-          std::filesystem::path precompiled_header{};
-          while (std::getline(read_file, first_line))
-          {
-            if (first_line.empty()) continue;
-            if (first_line.find("#include") == std::string::npos) break;
-            const std::regex include_regex(R"(#include\s*["<](.*)[">])");
-            std::smatch match{};
-            if (std::regex_search(first_line, match, include_regex))
-            {
-              const std::filesystem::path include_path{match.str(1)};
-              for (const auto &header : precompiled_headers)
-              {
-                if (include_path.filename() == header.filename())
-                {
-                  precompiled_header = header;
-                  break;
-                }
-              }
-            }
-          }
-          read_file.close();
-          std::string pch_flags{};
-          if (!precompiled_header.empty())
-            pch_flags = std::format(R"(/Yu"{}" /Fp"{}" )", precompiled_header.filename().string(),
-                                    (pch_directory / (precompiled_header.stem().string() + ".pch")).string());
-
-          std::string compiler{};
-          if (file.extension() == ".c")
-            compiler = "cl /std:c17 /TC";
-          else
-            compiler = "cl /std:c++" + std::to_string(cxx_standard);
-          return std::format("{} /nologo /W{} /WX /external:W0 {}/bigobj /Zc:preprocessor /EHsc /MP /{} "
-                             "{}/ifcOutput{}\\ /Fo{}\\ /Fd\"{}\" "
-                             "/sourceDependencies\"{}\" {}{}/c {}\"()\"",
-                             compiler, std::to_string(warning_level), compile_debug_flags, runtime_library,
-                             compile_definitions, utility::build_directory.string(), utility::build_directory.string(),
-                             (utility::build_directory / "(stem).pdb").string(),
-                             (utility::build_directory / "(stem).d").string(), compile_include_directories,
-                             compile_external_include_directories, pch_flags);
-        },
-        source_files, check_files, dependency_handler);
+      // Jobs with a deferred check may all turn out to be up to date, so the section only opens once one starts.
+      bool started{};
+      std::mutex started_mutex{};
+      auto on_start{[&started, &started_mutex](const std::filesystem::path &,
+                                               const std::vector<std::filesystem::path> &outputs, const std::string &)
+                    {
+                      {
+                        const std::scoped_lock<std::mutex> lock(started_mutex);
+                        if (!started) print<COUT>("\n{}", small_section_divider());
+                        started = true;
+                      }
+                      for (const auto &output : outputs)
+                        if (output.has_parent_path()) std::filesystem::create_directories(output.parent_path());
+                    }};
+      auto on_success{[&commands](const std::filesystem::path &, const std::vector<std::filesystem::path> &outputs,
+                                  const std::string &item_command, const std::string &output)
+                      {
+                        auto trimmed_output{trim(output)};
+                        print<COUT>("\n{}\n{}", item_command, (trimmed_output.empty() ? "" : trimmed_output + "\n"));
+                        for (const auto &file : outputs) touch(file);
+                        if (const auto &finish{commands.at(outputs.front())->finish}) finish();
+                      }};
+      std::vector<job> fallbacks{};
+      std::mutex fallbacks_mutex{};
+      auto on_failure{[&commands, &fallbacks, &fallbacks_mutex](
+                        const std::filesystem::path &, const std::vector<std::filesystem::path> &outputs,
+                        const std::string &item_command, const int return_code, const std::string &output)
+                      {
+                        if (const auto &fallback{commands.at(outputs.front())->fallback}; !fallback.empty())
+                        {
+                          print<COUT>("\n{} -> {}\nRetrying each file on its own.\n", item_command,
+                                      std::to_string(return_code));
+                          const std::scoped_lock<std::mutex> lock(fallbacks_mutex);
+                          fallbacks.insert(fallbacks.end(), fallback.begin(), fallback.end());
+                          return;
+                        }
+                        auto trimmed_output{trim(output)};
+                        print<COUT>("\n{} -> {}\n{}", item_command, std::to_string(return_code),
+                                    (trimmed_output.empty() ? "" : trimmed_output + "\n"));
+                        throw std::runtime_error("Task failed.");
+                      }};
+      multi_execute(std::function<std::string(const std::filesystem::path &, const std::vector<std::filesystem::path> &,
+                                              const std::vector<std::filesystem::path> &)>(
+                      [&commands](const std::filesystem::path &, const std::vector<std::filesystem::path> &,
+                                  const std::vector<std::filesystem::path> &outputs)
+                      {
+                        const auto &current{*commands.at(outputs.front())};
+                        if (current.modified && !current.modified()) return std::string{};
+                        return current.command();
+                      }),
+                    items, on_start, on_success, on_failure);
+
+      if (started) print<COUT>("{}\n", small_section_divider());
+      run_jobs(fallbacks);
     }
-    else if (host_platform == LINUX)
+
+    /**
+     * Maps the source files of a target to the precompiled header force included into them, earlier bindings winning.
+     * A header bound to every source only binds the sources of its own language, C for ".h" headers and C++ otherwise.
+     */
+    inline std::unordered_map<std::filesystem::path, std::filesystem::path>
+    precompiled_header_bindings(const target &item)
     {
-      std::string compile_debug_flags{target_configuration == RELEASE ? "-O3 " : "-Og -g "};
-      std::string compile_pic_flag{target_artifact == DYNAMIC_LIBRARY ? "-fPIC " : ""};
-      std::string compile_definitions{"-D__linux__ "};
-      compile_definitions += target_configuration == RELEASE ? "-DNDEBUG " : "-D_DEBUG ";
-      for (const auto &definition : definitions) compile_definitions += std::format("-D{} ", definition);
-      std::vector<std::filesystem::path> include_directories{};
-      for (const auto &include_file : include_files)
-        if (include_file.has_parent_path() &&
-            std::ranges::find(include_directories, include_file.parent_path()) == include_directories.end())
-          include_directories.push_back(include_file.parent_path());
-      for (const auto &header : precompiled_headers)
-        if (header.has_parent_path() &&
-            std::ranges::find(include_directories, header.parent_path()) == include_directories.end())
-          include_directories.push_back(header.parent_path());
-      if (!precompiled_headers.empty())
-        include_directories.insert(include_directories.begin(), utility::build_directory / "pch");
-      std::string compile_include_directories{};
-      for (const auto &directory : include_directories)
-        compile_include_directories += std::format("-I\"{}\" ", directory.string());
-      std::string compile_external_include_directories{};
-      for (const auto &directory : external_include_directories)
-        compile_external_include_directories += std::format("-isystem\"{}\" ", directory.string());
-      std::string warning_flags{"-Werror "};
-      if (warning_level >= W1) warning_flags += "-Wall ";
-      if (warning_level >= W2) warning_flags += "-Wextra ";
-      if (warning_level >= W3) warning_flags += "-Wpedantic ";
-      if (warning_level >= W4)
-        warning_flags += "-Wconversion -Wshadow -Wundef -Wdeprecated -Wtype-limits -Wcast-qual -Wcast-align "
-                         "-Wfloat-equal -Wformat=2 ";
-
-      auto dependency_handler{
-        [](const std::filesystem::path &file, const std::vector<std::filesystem::path> &checked_files) -> bool
-        {
-          auto object_time{std::filesystem::last_write_time(checked_files.at(0))};
-          const std::filesystem::path &dependency_path{checked_files.at(1)};
-
-          std::ifstream dependency_file(dependency_path);
-          if (!dependency_file.is_open()) return true;
-          std::string line{};
-          std::string full_content{};
-          while (std::getline(dependency_file, line))
+      std::unordered_map<std::filesystem::path, std::filesystem::path> bindings{};
+      for (const auto &[header, sources] : item.precompiled_header_sources)
+      {
+        if (!contains(item.precompiled_headers, header))
+          throw std::runtime_error(std::format("Precompiled header source list names a header that is not one of the "
+                                               "target's precompiled headers: {}.",
+                                               header.string()));
+        const bool c_header{header.extension() == ".h"};
+        for (const auto &file : sources.empty() ? item.source_files : sources)
+        {
+          if ((file.extension() == ".c") == c_header)
+            bindings.try_emplace(file, header);
+          else if (!sources.empty())
+            throw std::runtime_error(std::format("Precompiled header {} cannot be used by {}, which is written in "
+                                                 "another language.",
+                                                 header.string(), file.string()));
+        }
+      }
+      return bindings;
+    }
+
+    // Returns the precompiled header bound to a source file, or an empty path if no header is bound to it.
+    inline std::filesystem::path
+    bound_precompiled_header(const std::unordered_map<std::filesystem::path, std::filesystem::path> &bindings,
+                             const std::filesystem::path &file)
+    {
+      const auto binding{bindings.find(file)};
+      return binding == bindings.end() ? std::filesystem::path{} : binding->second;
+    }
+
+    // Returns the paths listed as prerequisites in a make dependency file.
+    inline std::vector<std::filesystem::path> make_dependencies(const std::filesystem::path &file)
+    {
+      std::string content{};
+      for (auto line : read_file<std::vector<std::string>>(file))
+      {
+        if (!line.empty() && line.back() == '\\') line.pop_back();
+        content += line + " ";
+      }
+      std::vector<std::filesystem::path> dependencies{};
+      const size_t colon_pos{content.find(':')};
+      if (colon_pos == std::string::npos) return dependencies;
+      std::istringstream stream{content.substr(colon_pos + 1)};
+      std::string dependency{};
+      while (stream >> dependency) dependencies.emplace_back(dependency);
+      return dependencies;
+    }
+
+    // Returns the hash of a file's content.
+    inline std::uint64_t file_signature(const std::filesystem::path &file)
+    {
+      const auto content{read_file<std::vector<std::byte>>(file)};
+      return csp::signature(content.data(), content.size());
+    }
+
+    // Returns the version and target of a compiler program, asking each program only once per run.
+    inline std::string compiler_identity(const std::string &program)
+    {
+      static std::unordered_map<std::string, std::string> identities{};
+      static std::mutex identities_mutex{};
+      const std::scoped_lock<std::mutex> lock(identities_mutex);
+      if (const auto found{identities.find(program)}; found != identities.end()) return found->second;
+      std::string identity{};
+      execute(
+        program + " -dumpfullversion -dumpmachine", nullptr,
+        [&identity](const std::string &, const std::string &output) { identity = trim(output); },
+        [&program](const std::string &, const int return_code, const std::string &)
+        {
+          throw std::runtime_error(
+            std::format("Failed to identify the compiler {}. Exited with: {}", program, std::to_string(return_code)));
+        });
+      return identities.emplace(program, identity).first->second;
+    }
+
+    /**
+     * Returns the dependencies of a precompiled header store entry resolved against the search directories of the
+     * current project, or nothing if the entry does not exist or any dependency differs in content.
+     *
+     * Dependencies are recorded relative to the search directory they were found in, so a project with the same headers
+     * in different places still matches.
+     */
+    inline std::optional<std::vector<std::filesystem::path>>
+    stored_precompiled_header(const std::filesystem::path &entry,
+                              const std::vector<std::filesystem::path> &search_directories)
+    {
+      if (!std::filesystem::exists(entry / "manifest") || !std::filesystem::exists(entry / "header.gch"))
+        return std::nullopt;
+      std::vector<std::filesystem::path> dependencies{};
+      for (const auto &line : read_file<std::vector<std::string>>(entry / "manifest"))
+      {
+        std::istringstream stream{line};
+        long long index{};
+        std::string hash{};
+        std::string path{};
+        if (!(stream >> index >> hash) || !std::getline(stream >> std::ws, path)) return std::nullopt;
+        if (index >= static_cast<long long>(search_directories.size())) return std::nullopt;
+        const auto dependency{index < 0 ? std::filesystem::path{path}
+                                        : search_directories.at(static_cast<std::size_t>(index)) / path};
+        if (!std::filesystem::exists(dependency) || std::format("{:016x}", file_signature(dependency)) != hash)
+          return std::nullopt;
+        dependencies.push_back(dependency.lexically_normal());
+      }
+      return dependencies;
+    }
+
+    // Adds a compiled precompiled header to the store along with the content hashes of everything it includes.
+    inline void store_precompiled_header(const std::filesystem::path &entry, const std::filesystem::path &gch,
+                                         const std::filesystem::path &dependency_file,
+                                         const std::vector<std::filesystem::path> &search_directories,
+                                         const std::filesystem::path &pch_directory)
+    {
+      if (std::filesystem::exists(entry)) return;
+      std::string manifest{};
+      for (const auto &dependency : make_dependencies(dependency_file))
+      {
+        auto within{[&dependency](const std::filesystem::path &directory)
+                    {
+                      const auto relative{
+                        dependency.lexically_normal().lexically_relative(directory.lexically_normal())};
+                      return !relative.empty() && *relative.begin() != ".." ? relative : std::filesystem::path{};
+                    }};
+        if (!within(pch_directory).empty()) continue;
+        std::string line{std::format("-1 {:016x} {}", file_signature(dependency),
+                                     std::filesystem::absolute(dependency).lexically_normal().string())};
+        for (std::size_t index{}; index < search_directories.size(); ++index)
+          if (const auto relative{within(search_directories.at(index))}; !relative.empty())
           {
-            if (line.empty()) continue;
-            if (line.back() == '\\') line.pop_back();
-            full_content += line + " ";
+            line = std::format("{} {:016x} {}", index, file_signature(dependency), relative.string());
+            break;
           }
-          dependency_file.close();
+        manifest += line + "\n";
+      }
+
+      // Entries are written aside and renamed into place so concurrent builds never see a partial entry.
+      const std::filesystem::path temporary{
+        std::format("{}.{}", entry.string(), std::chrono::steady_clock::now().time_since_epoch().count())};
+      std::filesystem::create_directories(temporary);
+      utility::copy_file(gch, temporary / "header.gch");
+      write_file<std::string>(temporary / "manifest", manifest);
+      std::error_code error{};
+      std::filesystem::rename(temporary, entry, error);
+      if (error) std::filesystem::remove_all(temporary, error);
+    }
+
+    // Returns the jobs for the out of date precompiled headers or source files of a target.
+    inline std::vector<job> compile_plan(const target &item, const std::filesystem::path &object_directory,
+                                         const bool headers)
+    {
+      std::vector<job> jobs{};
+      const auto pch_directory{object_directory / "pch"};
+      path_set include_set{};
+      if (!item.precompiled_headers.empty()) include_set.insert(pch_directory);
+      for (const auto &include_file : item.include_files)
+        if (include_file.has_parent_path()) include_set.insert(include_file.parent_path());
+      for (const auto &header : item.precompiled_headers)
+        if (header.has_parent_path()) include_set.insert(header.parent_path());
+      const auto &include_directories{include_set.paths};
+      const auto bindings{precompiled_header_bindings(item)};
+      const auto times{std::make_shared<file_times>()};
+      if (headers && !item.precompiled_headers.empty() && !std::filesystem::exists(pch_directory))
+        std::filesystem::create_directories(pch_directory);
 
-          const size_t colon_pos{full_content.find(':')};
-          if (colon_pos == std::string::npos) return true;
-          std::string dependencies{full_content.substr(colon_pos + 1)};
-          size_t pos{};
-          while (pos < dependencies.length())
+      if (host_platform == WINDOWS)
+      {
+        std::string compile_debug_flags{target_configuration.symbols ? "/Zi " : ""};
+        for (const auto &flag : target_configuration.compile_flags) compile_debug_flags += flag + " ";
+        const bool debug_runtime{target_configuration.runtime_library == DEBUG_RUNTIME};
+        std::string runtime_library{item.linkage_type == STATIC ? (debug_runtime ? "MTd" : "MT")
+                                                                : (debug_runtime ? "MDd" : "MD")};
+        std::string compile_definitions{"/D_WIN32 "};
+        compile_definitions += debug_runtime ? "/D_DEBUG " : "/DNDEBUG ";
+        for (const auto &definition : target_configuration.definitions)
+          compile_definitions += std::format("/D{} ", definition);
+        for (const auto &definition : item.definitions) compile_definitions += std::format("/D{} ", definition);
+        std::string compile_include_directories{};
+        for (const auto &directory : include_directories)
+          compile_include_directories += std::format("/I\"{}\" ", directory.string());
+        std::string compile_external_include_directories{};
+        for (const auto &directory : item.external_include_directories)
+          compile_external_include_directories += std::format("/external:I\"{}\" ", directory.string());
+
+        auto dependency_handler{
+          [times](const std::filesystem::path &, const std::vector<std::filesystem::path> &checked_files) -> bool
           {
-            while (pos < dependencies.length() && std::isspace(dependencies.at(pos))) pos++;
-            if (pos >= dependencies.length()) break;
-            size_t end{pos};
-            while (end < dependencies.length() && !std::isspace(dependencies.at(end))) end++;
-            const std::filesystem::path include_path{dependencies.substr(pos, end - pos)};
-            if (std::filesystem::exists(include_path))
-            {
-              auto include_time{std::filesystem::last_write_time(include_path)};
-              if (include_time > object_time) return true;
+            const auto object_time{times->at(checked_files.at(0))};
+            if (!object_time) return true;
+            const std::filesystem::path &dependency_path{checked_files.at(1)};
+
+            std::ifstream dependency_file(dependency_path);
+            if (!dependency_file.is_open()) return true;
+            const std::string json_content((std::istreambuf_iterator<char>(dependency_file)),
+                                           std::istreambuf_iterator<char>());
+            dependency_file.close();
+
+            const size_t includes_start{json_content.find("\"Includes\": [")};
+            if (includes_start == std::string::npos) return true;
+            const size_t includes_end{json_content.find(']', includes_start)};
+            if (includes_end == std::string::npos) return true;
+            const std::string includes_section{
+              json_content.substr(includes_start + 13, includes_end - includes_start - 13)};
+            size_t pos{};
+            while ((pos = includes_section.find('\"', pos)) != std::string::npos)
+            {
+              const size_t start{pos + 1};
+              const size_t end{includes_section.find('\"', start)};
+              if (end == std::string::npos) break;
+              const std::filesystem::path include_path{includes_section.substr(start, end - start)};
+              if (const auto include_time{times->at(include_path)}; include_time && *include_time > *object_time)
+                return true;
+              pos = end + 1;
+            }
+
+            const size_t pch_start{json_content.find(R"("PCH": ")")};
+            if (pch_start == std::string::npos) return false;
+            const size_t pch_end{json_content.find("\",", pch_start)};
+            if (pch_end == std::string::npos) return false;
+            const std::filesystem::path pch_path{json_content.substr(pch_start + 8, pch_end - pch_start - 8)};
+            const auto pch_time{times->at(pch_path)};
+            return pch_time && *pch_time > *object_time;
+          }};
+
+        if (headers)
+        {
+          std::vector<std::filesystem::path> check_files{pch_directory / "(filename.stem)_pch.obj",
+                                                         pch_directory / "(filename.stem)_pch.d",
+                                                         pch_directory / "(filename.stem).pch"};
+          if (target_configuration.symbols) check_files.push_back(pch_directory / "(filename.stem)_pch.pdb");
+          for (const auto &modified : find_modified_files(item.precompiled_headers, check_files, dependency_handler))
+            jobs.push_back(
+              {modified.first, modified.second,
+               [=, file = modified.first]()
+               {
+                 std::string relative_path{std::filesystem::relative(file, pch_directory).string()};
+                 for (const auto &character : relative_path)
+                   if (character == '/') relative_path.replace(relative_path.find(character), 1, "\\");
+                 update_file<std::string>(pch_directory / (file.stem().string() + "_pch.cpp"),
+                                          std::format("#include \"{}\"", relative_path));
+
+                 std::string compiler{};
+                 if (file.extension() == ".h")
+                   compiler = "cl /std:c17 /TC";
+                 else
+                   compiler = "cl /std:c++" + std::to_string(cxx_standard);
+                 return std::format("{} /nologo /W{} /WX /external:W0 {}/bigobj /Zc:preprocessor /EHsc /MP /{} "
+                                    "{}/ifcOutput{}\\ /Fo{}\\ /Fd\"{}\" "
+                                    "/sourceDependencies\"{}\" {}{}/c /Yc\"{}\" /Fp\"{}\" \"{}\"",
+                                    compiler, std::to_string(warning_level), compile_debug_flags, runtime_library,
+                                    compile_definitions, pch_directory.string(), pch_directory.string(),
+                                    (pch_directory / "(stem)_pch.pdb").string(),
+                                    (pch_directory / "(stem)_pch.d").string(), compile_include_directories,
+                                    compile_external_include_directories, relative_path,
+                                    (pch_directory / "(stem).pch").string(),
+                                    (pch_directory / "(stem)_pch.cpp").string());
+               }});
+          return jobs;
+        }
+
+        std::vector<std::string> check_extensions{".obj", ".d"};
+        if (target_configuration.symbols) check_extensions.emplace_back(".pdb");
+        const auto script_time{build_script_time()};
+        const auto expanded_files{object_check_files(item, object_directory, check_extensions)};
+        gather_file_times(*times, expanded_files);
+        for (const auto &modified : expanded_files)
+          jobs.push_back(
+            {modified.first, modified.second,
+             [=, file = modified.first, precompiled_headers = item.precompiled_headers,
+              forced = !item.precompiled_header_sources.empty(),
+              precompiled_header = bound_precompiled_header(bindings, modified.first),
+              output_directory = object_path(object_directory, modified.first, "").parent_path()]() mutable
+             {
+               if (forced)
+               {
+                 std::string pch_flags{};
+                 if (!precompiled_header.empty())
+                   pch_flags = std::format(R"(/FI"{}" /Yu"{}" /Fp"{}" )", precompiled_header.filename().string(),
+                                           precompiled_header.filename().string(),
+                                           (pch_directory / (precompiled_header.stem().string() + ".pch")).string());
+                 return std::format("{} /nologo /W{} /WX /external:W0 {}/bigobj /Zc:preprocessor /EHsc /MP /{} "
+                                    "{}/ifcOutput{}\\ /Fo{}\\ /Fd\"{}\" "
+                                    "/sourceDependencies\"{}\" {}{}/c {}\"()\"",
+                                    file.extension() == ".c" ? "cl /std:c17 /TC"
+                                                             : "cl /std:c++" + std::to_string(cxx_standard),
+                                    std::to_string(warning_level), compile_debug_flags, runtime_library,
+                                    compile_definitions, output_directory.string(), output_directory.string(),
+                                    (output_directory / "(stem).pdb").string(),
+                                    (output_directory / "(stem).d").string(), compile_include_directories,
+                                    compile_external_include_directories, pch_flags);
+               }
+               std::ifstream read_file(file);
+               if (!read_file.is_open())
+                 throw std::runtime_error("Failed to open source file for reading: " + file.string() + ".");
+               std::string first_line{};
+               while (std::getline(read_file, first_line))
+               {
+                 if (first_line.empty()) continue;
+                 if (first_line.find("#include") == std::string::npos) break;
+                 const std::regex include_regex(R"(#include\s*["<](.*)[">])");
+                 std::smatch match{};
+                 if (std::regex_search(first_line, match, include_regex))
+                 {
+                   const std::filesystem::path include_path{match.str(1)};
+                   for (const auto &header : precompiled_headers)
+                   {
+                     if (include_path.filename() == header.filename())
+                     {
+                       precompiled_header = header;
+                       break;
+                     }
+                   }
+                 }
+               }
+               read_file.close();
+               std::string pch_flags{};
+               if (!precompiled_header.empty())
+                 pch_flags = std::format(R"(/Yu"{}" /Fp"{}" )", precompiled_header.filename().string(),
+                                         (pch_directory / (precompiled_header.stem().string() + ".pch")).string());
+
+               std::string compiler{};
+               if (file.extension() == ".c")
+                 compiler = "cl /std:c17 /TC";
+               else
+                 compiler = "cl /std:c++" + std::to_string(cxx_standard);
+               return std::format("{} /nologo /W{} /WX /external:W0 {}/bigobj /Zc:preprocessor /EHsc /MP /{} "
+                                  "{}/ifcOutput{}\\ /Fo{}\\ /Fd\"{}\" "
+                                  "/sourceDependencies\"{}\" {}{}/c {}\"()\"",
+                                  compiler, std::to_string(warning_level), compile_debug_flags, runtime_library,
+                                  compile_definitions, output_directory.string(), output_directory.string(),
+                                  (output_directory / "(stem).pdb").string(), (output_directory / "(stem).d").string(),
+                                  compile_include_directories, compile_external_include_directories, pch_flags);
+             },
+             {},
+             {},
+             deferred_modified_check(modified.first, modified.second, dependency_handler, script_time, times)});
+      }
+      else if (host_platform == LINUX)
+      {
+        std::string compile_debug_flags{target_configuration.symbols ? "-g " : ""};
+        for (const auto &flag : target_configuration.compile_flags) compile_debug_flags += flag + " ";
+        if (target_configuration.symbols && !target_configuration.debug_compression.empty())
+          compile_debug_flags += std::format("-gz={} ", target_configuration.debug_compression);
+        const bool split_dwarf{target_configuration.symbols && target_configuration.split_dwarf};
+        std::string compile_pic_flag{item.artifact_type == DYNAMIC_LIBRARY ? "-fPIC " : ""};
+        std::string compile_definitions{"-D__linux__ "};
+        compile_definitions += target_configuration.runtime_library == DEBUG_RUNTIME ? "-D_DEBUG " : "-DNDEBUG ";
+        for (const auto &definition : target_configuration.definitions)
+          compile_definitions += std::format("-D{} ", definition);
+        for (const auto &definition : item.definitions) compile_definitions += std::format("-D{} ", definition);
+        std::string compile_include_directories{};
+        for (const auto &directory : include_directories)
+          compile_include_directories += std::format("-I\"{}\" ", directory.string());
+        std::string compile_external_include_directories{};
+        for (const auto &directory : item.external_include_directories)
+          compile_external_include_directories += std::format("-isystem\"{}\" ", directory.string());
+        std::string warning_flags{"-Werror "};
+        if (warning_level >= W1) warning_flags += "-Wall ";
+        if (warning_level >= W2) warning_flags += "-Wextra ";
+        if (warning_level >= W3) warning_flags += "-Wpedantic ";
+        if (warning_level >= W4)
+          warning_flags += "-Wconversion -Wshadow -Wundef -Wdeprecated -Wtype-limits -Wcast-qual -Wcast-align "
+                           "-Wfloat-equal -Wformat=2 ";
+
+        // Source checks can be deferred until their jobs run, so the handler keeps its own copies of what it reads.
+        auto dependency_handler{
+          [pch_directory, times, precompiled_headers = item.precompiled_headers,
+           forced = !item.precompiled_header_sources.empty(),
+           shared_bindings = std::make_shared<const decltype(bindings)>(bindings)](
+            const std::filesystem::path &file, const std::vector<std::filesystem::path> &checked_files) -> bool
+          {
+            const auto object_time{times->at(checked_files.at(0))};
+            if (!object_time) return true;
+            const std::filesystem::path &dependency_path{checked_files.at(1)};
+
+            std::ifstream dependency_file(dependency_path);
+            if (!dependency_file.is_open()) return true;
+            std::string line{};
+            std::string full_content{};
+            while (std::getline(dependency_file, line))
+            {
+              if (line.empty()) continue;
+              if (line.back() == '\\') line.pop_back();
+              full_content += line + " ";
+            }
+            dependency_file.close();
+
+            const size_t colon_pos{full_content.find(':')};
+            if (colon_pos == std::string::npos) return true;
+            std::string dependencies{full_content.substr(colon_pos + 1)};
+            size_t pos{};
+            while (pos < dependencies.length())
+            {
+              while (pos < dependencies.length() && std::isspace(dependencies.at(pos))) pos++;
+              if (pos >= dependencies.length()) break;
+              size_t end{pos};
+              while (end < dependencies.length() && !std::isspace(dependencies.at(end))) end++;
+              const std::filesystem::path include_path{dependencies.substr(pos, end - pos)};
+              if (const auto include_time{times->at(include_path)}; include_time && *include_time > *object_time)
+                return true;
+              pos = end;
             }
-            pos = end;
-          }
 
-          if (file.extension() != ".c" && file.extension() != ".cpp") return false;
-          std::ifstream read_file(file);
-          if (!read_file.is_open())
-            throw std::runtime_error("Failed to open source file for reading: " + file.string() + ".");
-          std::string first_line{};
-          while (std::getline(read_file, first_line))
-          {
-            if (first_line.empty()) continue;
-            if (first_line.find("#include") == std::string::npos) break;
-            const std::regex include_regex(R"(#include\s*["<](.*)[">])");
-            std::smatch match{};
-            if (std::regex_search(first_line, match, include_regex))
-            {
-              const std::filesystem::path include_path{match.str(1)};
-              for (const auto &header : precompiled_headers)
-                if (include_path.filename() == header.filename())
-                {
-                  auto pch_path{utility::build_directory / "pch" / (header.filename().string() + ".gch")};
-                  if (std::filesystem::exists(pch_path))
+            if (file.extension() != ".c" && file.extension() != ".cpp") return false;
+            if (forced)
+            {
+              const auto header{bound_precompiled_header(*shared_bindings, file)};
+              if (header.empty()) return false;
+              const auto pch_time{times->at(pch_directory / (header.filename().string() + ".gch"))};
+              return pch_time && *pch_time > *object_time;
+            }
+            std::ifstream read_file(file);
+            if (!read_file.is_open())
+              throw std::runtime_error("Failed to open source file for reading: " + file.string() + ".");
+            std::string first_line{};
+            while (std::getline(read_file, first_line))
+            {
+              if (first_line.empty()) continue;
+              if (first_line.find("#include") == std::string::npos) break;
+              const std::regex include_regex(R"(#include\s*["<](.*)[">])");
+              std::smatch match{};
+              if (std::regex_search(first_line, match, include_regex))
+              {
+                const std::filesystem::path include_path{match.str(1)};
+                for (const auto &header : precompiled_headers)
+                  if (include_path.filename() == header.filename())
                   {
-                    auto pch_time{std::filesystem::last_write_time(pch_path)};
-                    if (pch_time > object_time)
+                    const auto pch_time{times->at(pch_directory / (header.filename().string() + ".gch"))};
+                    if (pch_time && *pch_time > *object_time)
                     {
                       read_file.close();
                       return true;
                     }
+                    break;
                   }
-                  break;
-                }
+              }
             }
+            read_file.close();
+
+            return false;
+          }};
+
+        if (headers)
+        {
+          const std::vector<std::filesystem::path> check_files{pch_directory / "(filename).gch",
+                                                               pch_directory / "(filename).d"};
+          std::vector<std::filesystem::path> search_directories{};
+          for (const auto &directory : include_directories)
+            if (directory != pch_directory) search_directories.push_back(directory);
+          search_directories.insert(search_directories.end(), item.external_include_directories.begin(),
+                                    item.external_include_directories.end());
+          for (const auto &modified : find_modified_files(item.precompiled_headers, check_files, dependency_handler))
+          {
+            const auto &file{modified.first};
+            const std::string compiler{file.extension() == ".h" ? "gcc -std=c17"
+                                                                 : "g++ -std=c++" + std::to_string(cxx_standard)};
+            const auto gch{pch_directory / (file.filename().string() + ".gch")};
+            const auto dependency_file{pch_directory / (file.filename().string() + ".d")};
+            std::filesystem::path entry{};
+            if (!precompiled_header_store.empty())
+            {
+              const auto content{read_file<std::string>(file)};
+              const auto key{std::format("{}|{}|{}{}{}{}|{}|{}|{}", compiler,
+                                         compiler_identity(compiler.substr(0, compiler.find(' '))), warning_flags,
+                                         compile_debug_flags, compile_pic_flag, compile_definitions,
+                                         file.filename().string(), search_directories.size(), content)};
+              entry = precompiled_header_store / std::format("{:016x}", csp::signature(key.data(), key.size()));
+              if (auto dependencies{stored_precompiled_header(entry, search_directories)})
+              {
+                jobs.push_back({file, modified.second,
+                                [=]()
+                                {
+                                  utility::copy_file(file, pch_directory / file.filename());
+                                  std::string rule{std::format("{}:", gch.string())};
+                                  for (const auto &dependency : *dependencies) rule += " " + dependency.string();
+                                  write_file<std::string>(dependency_file, rule + "\n");
+                                  return std::format("cp \"{}\" \"{}\"", (entry / "header.gch").string(),
+                                                     gch.string());
+                                }});
+                continue;
+              }
+            }
+
+            const std::string command{std::format(
+              "{} {}{}{}-MMD -MP {}{}{}-c \"()\" -o \"{}\"", compiler, warning_flags, compile_debug_flags,
+              compile_pic_flag, compile_definitions, compile_include_directories,
+              compile_external_include_directories, gch.string())};
+            if (entry.empty())
+            {
+              jobs.push_back({file, modified.second,
+                              [=]()
+                              {
+                                utility::copy_file(file, pch_directory / file.filename());
+                                return command;
+                              }});
+              continue;
+            }
+            // The store records every dependency, system headers included, so it takes a full listing on top.
+            const auto store_dependency_file{pch_directory / (file.filename().string() + ".store.d")};
+            jobs.push_back(
+              {file, modified.second,
+               [=]()
+               {
+                 utility::copy_file(file, pch_directory / file.filename());
+                 return std::format("{} && {} {}{}{}{}{}{}-M \"()\" -MF \"{}\"", command, compiler, warning_flags,
+                                    compile_debug_flags, compile_pic_flag, compile_definitions,
+                                    compile_include_directories, compile_external_include_directories,
+                                    store_dependency_file.string());
+               },
+               {},
+               [=]()
+               { store_precompiled_header(entry, gch, store_dependency_file, search_directories, pch_directory); }});
           }
-          read_file.close();
+          return jobs;
+        }
 
-          return false;
-        }};
+        std::vector<std::string> check_extensions{".o", ".d"};
+        if (split_dwarf) check_extensions.emplace_back(".dwo");
+        auto compiler_for{[](const std::filesystem::path &file)
+                          {
+                            if (file.extension() == ".c") return std::string{"gcc -std=c17"};
+                            return "g++ -std=c++" + std::to_string(cxx_standard);
+                          }};
 
-      auto pch_directory{utility::build_directory / "pch"};
-      if (!precompiled_headers.empty() && !std::filesystem::exists(pch_directory))
-        std::filesystem::create_directories(pch_directory);
-      std::vector<std::filesystem::path> check_files{pch_directory / "(filename).gch", pch_directory / "(filename).d"};
-      multi_task_run(
-        [&](const auto &file, const std::vector<std::filesystem::path> &, const std::vector<std::filesystem::path> &)
-        {
-          std::filesystem::copy_file(file, pch_directory / file.filename(),
-                                     std::filesystem::copy_options::overwrite_existing);
+        // Batched sources are compiled from inside their object directory so the compiler names each output after its
+        // source, which needs every path on the command line to be absolute and every batch to share a directory.
+        std::string batch_include_directories{};
+        for (const auto &directory : include_directories)
+          batch_include_directories += std::format("-I\"{}\" ", std::filesystem::absolute(directory).string());
+        std::string batch_external_include_directories{};
+        for (const auto &directory : item.external_include_directories)
+          batch_external_include_directories +=
+            std::format("-isystem\"{}\" ", std::filesystem::absolute(directory).string());
+        std::map<std::tuple<std::string, std::filesystem::path, std::filesystem::path>, std::vector<job>> batches{};
+        auto flush_batch{
+          [&](const std::tuple<std::string, std::filesystem::path, std::filesystem::path> &batch_key)
+          {
+            const auto &[compiler, precompiled_header, output_directory]{batch_key};
+            auto &batch{batches[batch_key]};
+            if (batch.size() == 1) jobs.push_back(batch.front());
+            if (batch.size() <= 1)
+            {
+              batch.clear();
+              return;
+            }
+            std::vector<std::filesystem::path> outputs{};
+            std::string batch_sources{};
+            for (const auto &batched : batch)
+            {
+              outputs.insert(outputs.end(), batched.outputs.begin(), batched.outputs.end());
+              batch_sources += std::format("\"{}\" ", std::filesystem::absolute(batched.file).string());
+            }
+            const std::string include_flag{
+              precompiled_header.empty()
+                ? ""
+                : std::format("-include \"{}\" ",
+                              std::filesystem::absolute(pch_directory / precompiled_header.filename()).string())};
+            jobs.push_back({batch.front().file, outputs,
+                            [=]()
+                            {
+                              return std::format("cd \"{}\" && {} {}{}{}{}-MMD -MP {}{}{}{}-c {}",
+                                                 output_directory.string(), compiler, warning_flags,
+                                                 compile_debug_flags, split_dwarf ? "-gsplit-dwarf " : "",
+                                                 compile_pic_flag, compile_definitions, batch_include_directories,
+                                                 batch_external_include_directories, include_flag, batch_sources);
+                            },
+                            batch});
+            batch.clear();
+          }};
+
+        // Without batching every source gets a job whose check runs when the job does, so compiles start while the
+        // remaining sources are still being checked; batches need the full set of out of date sources up front.
+        const bool deferred{batch_size <= 1};
+        const auto script_time{build_script_time()};
+        auto candidates{object_check_files(item, object_directory, check_extensions)};
+        if (deferred)
+          gather_file_times(*times, candidates);
+        else
+          candidates = find_modified_files(std::move(candidates), dependency_handler);
+        for (const auto &modified : candidates)
+        {
+          const auto precompiled_header{bound_precompiled_header(bindings, modified.first)};
+          const std::string include_flag{
+            precompiled_header.empty()
+              ? ""
+              : std::format("-include \"{}\" ", (pch_directory / precompiled_header.filename()).string())};
+          job source_job{modified.first, modified.second,
+                         [=, file = modified.first, object = modified.second.front()]()
+                         {
+                           return std::format("{} {}{}{}{}-MMD -MP {}{}{}{}-c \"()\" -o \"{}\"",
+                                              compiler_for(file), warning_flags, compile_debug_flags,
+                                              split_dwarf ? "-gsplit-dwarf " : "", compile_pic_flag,
+                                              compile_definitions, compile_include_directories,
+                                              compile_external_include_directories, include_flag, object.string());
+                         }};
+          if (deferred)
+          {
+            source_job.modified =
+              deferred_modified_check(modified.first, modified.second, dependency_handler, script_time, times);
+            jobs.push_back(std::move(source_job));
+            continue;
+          }
+          if (std::filesystem::file_size(modified.first) > batch_file_size)
+          {
+            jobs.push_back(std::move(source_job));
+            continue;
+          }
+          const std::tuple batch_key{compiler_for(modified.first), precompiled_header,
+                                     modified.second.front().parent_path()};
+          batches[batch_key].push_back(std::move(source_job));
+          if (batches[batch_key].size() >= batch_size) flush_batch(batch_key);
+        }
+        for (const auto &batch : batches) flush_batch(batch.first);
+      }
+      return jobs;
+    }
 
-          std::string compiler{};
-          if (file.extension() == ".h")
-            compiler = "gcc -std=c17";
-          else
-            compiler = "g++ -std=c++" + std::to_string(cxx_standard);
-          return std::format("{} {}{}{}-MMD -MP {}{}{}-c \"()\" -o \"{}/(filename).gch\"", compiler, warning_flags,
-                             compile_debug_flags, compile_pic_flag, compile_definitions, compile_include_directories,
-                             compile_external_include_directories, pch_directory.string());
-        },
-        precompiled_headers, check_files, dependency_handler);
+    // Returns the partial link objects of a target mapped to the objects of the source directories they combine.
+    inline std::map<std::filesystem::path, std::vector<std::filesystem::path>>
+    partial_link_groups(const target &item, const std::filesystem::path &object_directory)
+    {
+      std::map<std::filesystem::path, std::vector<std::filesystem::path>> groups{};
+      for (const auto &source_file : item.source_files)
+      {
+        auto group{object_path(object_directory / "partial" / item.name, source_file, "").parent_path()};
+        group += ".o";
+        groups[group].push_back(object_path(object_directory, source_file, ".o"));
+      }
+      return groups;
+    }
 
-      check_files = {utility::build_directory / "(filename.stem).o", utility::build_directory / "(filename.stem).d"};
-      multi_task_run(
-        [&](const auto &file, const std::vector<std::filesystem::path> &, const std::vector<std::filesystem::path> &)
+    // Returns the jobs for the out of date partial links of a target, or none when partial links are not in use.
+    inline std::vector<job> partial_link_plan(const target &item, const std::filesystem::path &object_directory)
+    {
+      std::vector<job> jobs{};
+      if (!partial_links || host_platform != LINUX || item.artifact_type == STATIC_LIBRARY) return jobs;
+      for (const auto &[group, objects] : partial_link_groups(item, object_directory))
+      {
+        // Each group records its objects next to it, so one that loses or gains a source is linked again.
+        std::string members{};
+        for (const auto &object : objects) members += object.string() + '\n';
+        auto members_file{group};
+        members_file += ".members";
+        if (!same_content(members_file, members))
+        {
+          std::filesystem::remove(group);
+          replace_file(members_file, members);
+        }
+        if (find_modified_files(objects, {group}).empty()) continue;
+        std::string group_objects{};
+        for (const auto &object : objects) group_objects += std::format("\"{}\" ", object.string());
+        jobs.push_back(
+          {group, {group}, [=]() { return std::format("ld -r -o \"{}\" {}", group.string(), group_objects); }});
+      }
+      return jobs;
+    }
+
+    // Returns the member file names of an archive, or nothing if it is missing or not of the requested thin format.
+    inline std::optional<std::vector<std::filesystem::path>> archive_members(const std::filesystem::path &archive,
+                                                                             const bool thin)
+    {
+      std::ifstream input(archive, std::ios::binary);
+      if (!input.is_open()) return std::nullopt;
+      std::string magic(8, '\0');
+      if (!input.read(magic.data(), 8) || magic != (thin ? "!<thin>\n" : "!<arch>\n")) return std::nullopt;
+
+      std::vector<std::filesystem::path> members{};
+      std::string long_names{};
+      std::array<char, 60> header{};
+      while (input.read(header.data(), header.size()))
+      {
+        std::string name(header.data(), 16);
+        while (!name.empty() && name.back() == ' ') name.pop_back();
+        const auto size{std::stoull(std::string(header.data() + 48, 10))};
+        const bool table{name == "/" || name == "/SYM64/" || name == "//"};
+        if (name == "//")
         {
-          std::string compiler{};
-          if (file.extension() == ".c")
-            compiler = "gcc -std=c17";
-          else
-            compiler = "g++ -std=c++" + std::to_string(cxx_standard);
-          return std::format("{} {}{}{}-MMD -MP {}{}{}-c \"()\" -o \"{}/(stem).o\"", compiler, warning_flags,
-                             compile_debug_flags, compile_pic_flag, compile_definitions, compile_include_directories,
-                             compile_external_include_directories, utility::build_directory.string());
-        },
-        source_files, check_files, dependency_handler);
+          long_names.resize(size);
+          if (!input.read(long_names.data(), static_cast<std::streamsize>(size))) return std::nullopt;
+        }
+        else if (!thin || table)
+          input.seekg(static_cast<std::streamoff>(size), std::ios::cur);
+        if ((!thin || table) && size % 2 != 0) input.seekg(1, std::ios::cur);
+        if (table) continue;
+
+        if (name.size() > 1 && name.front() == '/')
+        {
+          const auto offset{std::stoull(name.substr(1))};
+          if (offset >= long_names.size()) return std::nullopt;
+          name = long_names.substr(offset, long_names.find('\n', offset) - offset);
+        }
+        if (!name.empty() && name.back() == '/') name.pop_back();
+        members.push_back(std::filesystem::path{name}.filename());
+      }
+      return members;
     }
-  }
 
-  // Links compiled object files into the final target artifact.
-  inline void link()
-  {
-    if (utility::build_directory.string().empty() || !std::filesystem::exists(utility::build_directory))
-      throw std::runtime_error("Link called before compile.");
+    // The directory to link libraries from in the active configuration, following compiled subprojects' library
+    // directories to the output of the same configuration.
+    inline std::filesystem::path configuration_library_directory(const std::filesystem::path &directory)
+    {
+      const auto found{subproject_builds.find(std::filesystem::path{directory}.make_preferred())};
+      return found == subproject_builds.end() ? directory : found->second / target_configuration.directory;
+    }
 
-    if (host_platform == WINDOWS)
+    // The stamp written once an artifact's debug information is packaged and the file holding the packager's process.
+    inline std::pair<std::filesystem::path, std::filesystem::path>
+    dwarf_package_records(const std::filesystem::path &artifact)
     {
-      std::string executable_option{target_artifact == STATIC_LIBRARY ? "lib" : "link"};
-      std::string console_option{target_subsystem == CONSOLE ? "CONSOLE" : "WINDOWS"};
-      std::string link_debug_flags{target_configuration == RELEASE     ? ""
-                                   : target_artifact == STATIC_LIBRARY ? ""
-                                                                       : "/DEBUG:FULL "};
-      std::string dynamic_flags{target_artifact == DYNAMIC_LIBRARY ? "/DLL /MANIFEST:EMBED /INCREMENTAL:NO "
-                                : target_artifact == EXECUTABLE    ? "/MANIFEST:EMBED /INCREMENTAL:NO "
-                                                                   : ""};
-      std::string output_flags{
-        target_artifact == DYNAMIC_LIBRARY
-          ? (target_configuration == RELEASE
-               ? std::format("/IMPLIB:{}.lib ", (utility::build_directory / target_name).string())
-               : std::format("/PDB:{}.pdb /IMPLIB:{}.lib ", (utility::build_directory / target_name).string(),
-                             (utility::build_directory / target_name).string()))
-        : target_artifact == EXECUTABLE
-          ? (target_configuration == RELEASE
-               ? ""
-               : std::format("/PDB:{}.pdb ", (utility::build_directory / target_name).string()))
-          : ""};
-      const std::string extension{target_artifact == STATIC_LIBRARY    ? std::string_view{"lib"}
-                                  : target_artifact == DYNAMIC_LIBRARY ? "dll"
-                                                                       : "exe"};
-      std::string link_library_directories{};
-      for (const auto &directory : library_directories)
-        link_library_directories += std::format("/LIBPATH:\"{}\" ", directory.string());
-      std::string link_libraries{};
-      for (const auto &library : libraries) link_libraries += std::format("{}.lib ", library);
-      std::string link_objects{};
-      for (const auto &source_file : source_files)
-        link_objects += std::format("\"{}.obj\" ", (utility::build_directory / source_file.stem()).string());
-      for (const auto &precompiled_header : precompiled_headers)
-        link_objects +=
-          std::format("{}_pch.obj ", (utility::build_directory / "pch" / precompiled_header.stem()).string());
+      const auto records{artifact.parent_path() / "dwp" / artifact.filename()};
+      return {records.string() + ".stamp", records.string() + ".pid"};
+    }
 
-      std::vector<std::filesystem::path> target_files{};
-      target_files.reserve((source_files.size() * 2) + include_files.size() + precompiled_headers.size());
-      target_files.insert(target_files.end(), source_files.begin(), source_files.end());
-      target_files.insert(target_files.end(), include_files.begin(), include_files.end());
-      for (const auto &source_file : source_files)
-        target_files.push_back(utility::build_directory / (source_file.stem().string() + ".obj"));
-      for (const auto &precompiled_header : precompiled_headers)
-        target_files.push_back(utility::build_directory / "pch" / (precompiled_header.stem().string() + ".pch"));
-      std::vector<std::filesystem::path> check_files{utility::build_directory / (target_name + "." + extension)};
-      if (target_configuration == DEBUG) check_files.push_back(utility::build_directory / (target_name + ".pdb"));
-
-      task_run(std::format("{} /NOLOGO /MACHINE:{} {}/SUBSYSTEM:{} {}{}{}{}{}/OUT:\"{}\"", executable_option,
-                           host_architecture, dynamic_flags, console_option, link_debug_flags, link_library_directories,
-                           link_libraries, link_objects, output_flags,
-                           (utility::build_directory / (target_name + "." + extension)).string()),
-               target_files, check_files);
+    // A command prefix, with placeholder characters escaped, that stops a running packager of an artifact's debug
+    // information.
+    inline std::string stop_dwarf_packager(const std::filesystem::path &artifact)
+    {
+      const auto process{dwarf_package_records(artifact).second};
+      return std::format("{{ [[ ! -s \"{}\" ]] || kill $((cat \"{}\")) 2> /dev/null; rm -f \"{}\"; }}; ",
+                         process.string(), process.string(), process.string());
     }
-    else if (host_platform == LINUX)
+
+    // Returns the link command of a target along with its target and check files.
+    inline std::tuple<std::string, std::vector<std::filesystem::path>, std::vector<std::filesystem::path>>
+    link_plan(const target &item, const std::filesystem::path &object_directory,
+              const std::filesystem::path &artifact_directory, const std::vector<const target *> &dependencies)
     {
-      const std::string extension{target_artifact == STATIC_LIBRARY    ? "a"
-                                  : target_artifact == DYNAMIC_LIBRARY ? "so"
-                                                                       : ""};
-      const std::string output_name{(target_artifact == STATIC_LIBRARY || target_artifact == DYNAMIC_LIBRARY)
-                                      ? "lib" + target_name + "." + extension
-                                      : target_name};
-      std::string runtime_linkage{target_linkage == STATIC ? "-static-libstdc++ -static-libgcc " : ""};
+      std::vector<std::filesystem::path> library_directories{};
+      for (const auto &directory : item.library_directories)
+        library_directories.push_back(configuration_library_directory(directory));
+      std::vector<std::string> libraries{};
+      std::vector<std::filesystem::path> dependency_artifacts{};
+      bool dynamic_dependencies{};
+      if (!dependencies.empty()) library_directories.push_back(artifact_directory);
+      for (const auto *dependency : dependencies)
+      {
+        if (dependency->artifact_type == EXECUTABLE)
+          throw std::runtime_error("Target '" + item.name + "' cannot depend on executable: " + dependency->name + ".");
+        libraries.push_back(dependency->name);
+        if (dependency->artifact_type == DYNAMIC_LIBRARY) dynamic_dependencies = true;
+        if (host_platform == WINDOWS)
+          dependency_artifacts.push_back(artifact_directory / (dependency->name + ".lib"));
+        else
+          dependency_artifacts.push_back(artifact_directory /
+                                         ("lib" + dependency->name +
+                                          (dependency->artifact_type == STATIC_LIBRARY ? ".a" : ".so")));
+      }
+      libraries.insert(libraries.end(), item.libraries.begin(), item.libraries.end());
+
+      if (host_platform == WINDOWS)
+      {
+        std::string executable_option{item.artifact_type == STATIC_LIBRARY ? "lib" : "link"};
+        std::string console_option{item.subsystem_type == CONSOLE ? "CONSOLE" : "WINDOWS"};
+        std::string link_debug_flags{!target_configuration.symbols          ? ""
+                                     : item.artifact_type == STATIC_LIBRARY ? ""
+                                                                            : "/DEBUG:FULL "};
+        if (item.artifact_type != STATIC_LIBRARY)
+          for (const auto &flag : target_configuration.link_flags) link_debug_flags += flag + " ";
+        std::string dynamic_flags{item.artifact_type == DYNAMIC_LIBRARY ? "/DLL /MANIFEST:EMBED /INCREMENTAL:NO "
+                                  : item.artifact_type == EXECUTABLE    ? "/MANIFEST:EMBED /INCREMENTAL:NO "
+                                                                        : ""};
+        std::string output_flags{
+          item.artifact_type == DYNAMIC_LIBRARY
+            ? (!target_configuration.symbols
+                 ? std::format("/IMPLIB:{}.lib ", (artifact_directory / item.name).string())
+                 : std::format("/PDB:{}.pdb /IMPLIB:{}.lib ", (artifact_directory / item.name).string(),
+                               (artifact_directory / item.name).string()))
+          : item.artifact_type == EXECUTABLE
+            ? (!target_configuration.symbols ? ""
+                                             : std::format("/PDB:{}.pdb ", (artifact_directory / item.name).string()))
+            : ""};
+        const std::string extension{item.artifact_type == STATIC_LIBRARY    ? std::string_view{"lib"}
+                                    : item.artifact_type == DYNAMIC_LIBRARY ? "dll"
+                                                                            : "exe"};
+        std::string link_library_directories{};
+        for (const auto &directory : library_directories)
+          link_library_directories += std::format("/LIBPATH:\"{}\" ", directory.string());
+        std::string link_libraries{};
+        for (const auto &library : libraries) link_libraries += std::format("{}.lib ", library);
+        std::string link_objects{};
+        for (const auto &source_file : item.source_files)
+          link_objects += std::format("\"{}\" ", object_path(object_directory, source_file, ".obj").string());
+        for (const auto &precompiled_header : item.precompiled_headers)
+          link_objects +=
+            std::format("{}_pch.obj ", (object_directory / "pch" / precompiled_header.stem()).string());
+        for (const auto &object : item.object_files) link_objects += std::format("\"{}\" ", object.string());
+
+        std::vector<std::filesystem::path> target_files{};
+        target_files.reserve((item.source_files.size() * 2) + item.include_files.size() +
+                             item.precompiled_headers.size() + item.object_files.size() + dependency_artifacts.size());
+        target_files.insert(target_files.end(), item.source_files.begin(), item.source_files.end());
+        target_files.insert(target_files.end(), item.include_files.begin(), item.include_files.end());
+        for (const auto &source_file : item.source_files)
+          target_files.push_back(object_path(object_directory, source_file, ".obj"));
+        for (const auto &precompiled_header : item.precompiled_headers)
+          target_files.push_back(object_directory / "pch" / (precompiled_header.stem().string() + ".pch"));
+        target_files.insert(target_files.end(), item.object_files.begin(), item.object_files.end());
+        target_files.insert(target_files.end(), dependency_artifacts.begin(), dependency_artifacts.end());
+        std::vector<std::filesystem::path> check_files{artifact_directory / (item.name + "." + extension)};
+        if (target_configuration.symbols) check_files.push_back(artifact_directory / (item.name + ".pdb"));
+
+        return {std::format("{} /NOLOGO /MACHINE:{} {}/SUBSYSTEM:{} {}{}{}{}{}/OUT:\"{}\"", executable_option,
+                            host_architecture, dynamic_flags, console_option, link_debug_flags,
+                            link_library_directories, link_libraries, link_objects, output_flags,
+                            (artifact_directory / (item.name + "." + extension)).string()),
+                target_files, check_files};
+      }
+
+      const std::string extension{item.artifact_type == STATIC_LIBRARY    ? "a"
+                                  : item.artifact_type == DYNAMIC_LIBRARY ? "so"
+                                                                          : ""};
+      const std::string output_name{(item.artifact_type == STATIC_LIBRARY || item.artifact_type == DYNAMIC_LIBRARY)
+                                      ? "lib" + item.name + "." + extension
+                                      : item.name};
+      std::string runtime_linkage{item.linkage_type == STATIC ? "-static-libstdc++ -static-libgcc " : ""};
+      for (const auto &flag : target_configuration.link_flags) runtime_linkage += flag + " ";
+      if (target_configuration.symbols && !target_configuration.debug_compression.empty())
+        runtime_linkage += std::format("-gz={} ", target_configuration.debug_compression);
+      if (target_configuration.symbols && target_configuration.gdb_index) runtime_linkage += "-Wl,--gdb-index ";
+      if (dynamic_dependencies) runtime_linkage += "-Wl,-rpath,'$ORIGIN' ";
       std::string link_library_directories{};
       for (const auto &directory : library_directories)
         link_library_directories += std::format("-L\"{}\" ", directory.string());
       std::string link_libraries{};
       for (const auto &library : libraries) link_libraries += std::format("-l{} ", library);
+      std::vector<std::filesystem::path> objects{};
+      if (partial_links && item.artifact_type != STATIC_LIBRARY)
+        for (const auto &group : partial_link_groups(item, object_directory)) objects.push_back(group.first);
+      else
+        for (const auto &source_file : item.source_files)
+          objects.push_back(object_path(object_directory, source_file, ".o"));
+      objects.insert(objects.end(), item.object_files.begin(), item.object_files.end());
       std::string link_objects{};
-      for (const auto &source_file : source_files)
-        link_objects += std::format("\"{}.o\" ", (utility::build_directory / source_file.stem()).string());
+      for (const auto &object : objects) link_objects += std::format("\"{}\" ", object.string());
 
       std::vector<std::filesystem::path> target_files{};
-      target_files.reserve((source_files.size() * 2) + include_files.size() + precompiled_headers.size());
-      target_files.insert(target_files.end(), source_files.begin(), source_files.end());
-      target_files.insert(target_files.end(), include_files.begin(), include_files.end());
-      for (const auto &source_file : source_files)
-        target_files.push_back(utility::build_directory / (source_file.stem().string() + ".o"));
-      for (const auto &precompiled_header : precompiled_headers)
-        target_files.push_back(utility::build_directory / "pch" / (precompiled_header.filename().string() + ".gch"));
-      const std::vector<std::filesystem::path> check_files{utility::build_directory / output_name};
+      target_files.reserve(item.source_files.size() + objects.size() + item.include_files.size() +
+                           item.precompiled_headers.size() + dependency_artifacts.size());
+      target_files.insert(target_files.end(), item.source_files.begin(), item.source_files.end());
+      target_files.insert(target_files.end(), item.include_files.begin(), item.include_files.end());
+      target_files.insert(target_files.end(), objects.begin(), objects.end());
+      for (const auto &precompiled_header : item.precompiled_headers)
+        target_files.push_back(object_directory / "pch" / (precompiled_header.filename().string() + ".gch"));
+      target_files.insert(target_files.end(), dependency_artifacts.begin(), dependency_artifacts.end());
+      const std::vector<std::filesystem::path> check_files{artifact_directory / output_name};
 
       std::string command{};
-      if (target_artifact == STATIC_LIBRARY)
-        command = std::format("ar rcs {} {}", (utility::build_directory / output_name).string(), link_objects);
-      else if (target_artifact == DYNAMIC_LIBRARY)
+      if (item.artifact_type == STATIC_LIBRARY)
+      {
+        const auto archive{artifact_directory / output_name};
+        const auto archive_flags{thin_archives ? "rcsT" : "rcs"};
+        std::vector<std::filesystem::path> member_names{};
+        for (const auto &object : objects) member_names.push_back(object.filename());
+        auto members{archive_members(archive, thin_archives)};
+        if (members) std::ranges::sort(*members);
+        std::ranges::sort(member_names);
+        // ar replaces members by file name, so objects of same named sources in different directories are only ever
+        // appended to a fresh archive.
+        const bool unique_names{std::ranges::adjacent_find(member_names) == member_names.end()};
+        if (unique_names && members && *members == member_names)
+        {
+          const auto archive_time{std::filesystem::last_write_time(archive)};
+          std::string changed_objects{};
+          for (const auto &object : objects)
+            if (!std::filesystem::exists(object) || std::filesystem::last_write_time(object) > archive_time)
+              changed_objects += std::format("\"{}\" ", object.string());
+          command = std::format("ar {} {} {}", archive_flags, archive.string(), changed_objects);
+        }
+        else
+          command = std::format("rm -f {} && ar {} {} {}", archive.string(), thin_archives ? "qcsT" : "qcs",
+                                archive.string(), link_objects);
+      }
+      else if (item.artifact_type == DYNAMIC_LIBRARY)
         command =
-          std::format("g++ -shared {}-o {} {}{}{}", runtime_linkage, (utility::build_directory / output_name).string(),
+          std::format("g++ -shared {}-o {} {}{}{}", runtime_linkage, (artifact_directory / output_name).string(),
                       link_objects, link_library_directories, link_libraries);
       else
-        command = std::format("g++ {}-o {} {}{}{}", runtime_linkage, (utility::build_directory / output_name).string(),
+        command = std::format("g++ {}-o {} {}{}{}", runtime_linkage, (artifact_directory / output_name).string(),
                               link_objects, link_library_directories, link_libraries);
+      if (item.artifact_type != STATIC_LIBRARY && target_configuration.symbols && target_configuration.split_dwarf &&
+          target_configuration.package_dwarf)
+        command = stop_dwarf_packager(artifact_directory / output_name) + command;
+      return {command, target_files, check_files};
+    }
+
+    // Returns the job that packages the split debug information of a target into a .dwp, if it is out of date.
+    inline std::vector<job> dwarf_package_plan(const target &item, const std::filesystem::path &artifact_directory)
+    {
+      std::vector<job> jobs{};
+      if (host_platform != LINUX || item.artifact_type == STATIC_LIBRARY || !target_configuration.symbols ||
+          !target_configuration.split_dwarf || !target_configuration.package_dwarf)
+        return jobs;
+      const auto artifact{artifact_directory /
+                          (item.artifact_type == DYNAMIC_LIBRARY ? "lib" + item.name + ".so" : item.name)};
+      const auto package{std::filesystem::path{artifact.string() + ".dwp"}};
+      const auto [stamp, process]{dwarf_package_records(artifact)};
+      if (find_modified_files({artifact}, {stamp}).empty()) return jobs;
+      // The packager runs detached and records its process, so that the stamp is only written once it succeeds and a
+      // relink or a newer packaging can stop it first.
+      jobs.push_back({artifact, {process},
+                      [=]()
+                      {
+                        return std::format("{}((dwp -e \"{}\" -o \"{}\" & echo $! > \"{}\"; wait $! && touch \"{}\"; "
+                                           "rm -f \"{}\")) < /dev/null > /dev/null 2>&1 &",
+                                           stop_dwarf_packager(artifact), artifact.string(), package.string(),
+                                           process.string(), stamp.string(), process.string());
+                      }});
+      return jobs;
+    }
+
+    // Groups targets into levels in which every target only depends on targets of earlier levels.
+    inline std::vector<std::vector<const target *>> target_levels(const std::vector<target> &targets)
+    {
+      std::unordered_map<std::string, const target *> named{};
+      for (const auto &item : targets)
+        if (!named.emplace(item.name, &item).second)
+          throw std::runtime_error("Target name given more than once: " + item.name + ".");
+      std::unordered_map<std::string, std::size_t> depth{};
+      std::function<std::size_t(const target &, std::vector<std::string> &)> resolve{
+        [&](const target &item, std::vector<std::string> &visiting) -> std::size_t
+        {
+          if (const auto found{depth.find(item.name)}; found != depth.end()) return found->second;
+          if (std::ranges::find(visiting, item.name) != visiting.end())
+            throw std::runtime_error("Target dependency cycle detected at: " + item.name + ".");
+          visiting.push_back(item.name);
+          std::size_t level{};
+          for (const auto &dependency : item.dependencies)
+          {
+            const auto found{named.find(dependency)};
+            if (found == named.end())
+              throw std::runtime_error("Target '" + item.name + "' depends on unknown target: " + dependency + ".");
+            level = std::max(level, resolve(*found->second, visiting) + 1);
+          }
+          visiting.pop_back();
+          depth.emplace(item.name, level);
+          return level;
+        }};
+      std::vector<std::vector<const target *>> levels{};
+      for (const auto &item : targets)
+      {
+        std::vector<std::string> visiting{};
+        const auto level{resolve(item, visiting)};
+        if (levels.size() <= level) levels.resize(level + 1);
+        levels.at(level).push_back(&item);
+      }
+      return levels;
+    }
+
+    /**
+     * Calls a planning function once for every build configuration with that configuration active, then restores the
+     * first configuration.
+     *
+     * While a configuration is active the build directory points at its output directory and library directories of
+     * compiled subprojects point at the subproject's output for that configuration.
+     */
+    template <typename function> void for_each_configuration(const function &plan)
+    {
+      const auto configurations{build_configurations.empty() ? std::vector<configuration>{target_configuration}
+                                                             : build_configurations};
+      const auto primary{configurations.front()};
+      const auto primary_directories{library_directories};
+      for (const auto &item : configurations)
+      {
+        target_configuration = item;
+        build_directory = configuration_directory().make_preferred();
+        if (!std::filesystem::exists(build_directory)) std::filesystem::create_directories(build_directory);
+        library_directories.clear();
+        for (const auto &directory : primary_directories)
+          library_directories.push_back(configuration_library_directory(directory));
+        plan();
+      }
+      target_configuration = primary;
+      build_directory = configuration_directory().make_preferred();
+      library_directories = primary_directories;
+    }
+
+    // Validates targets and returns them with their paths in preferred form.
+    inline std::vector<target> preferred_targets(std::vector<target> targets)
+    {
+      if (targets.empty()) throw std::runtime_error("No targets given.");
+      for (auto &item : targets)
+      {
+        if (item.name.empty()) throw std::runtime_error("Target name not set.");
+        if (item.source_files.empty()) throw std::runtime_error("No source files to compile for: " + item.name + ".");
+        for (auto &file : item.source_files) file.make_preferred();
+        for (auto &file : item.include_files) file.make_preferred();
+        for (auto &file : item.precompiled_headers) file.make_preferred();
+        for (auto &dir : item.external_include_directories) dir.make_preferred();
+        for (auto &dir : item.library_directories) dir.make_preferred();
+        for (auto &[header, sources] : item.precompiled_header_sources)
+        {
+          header.make_preferred();
+          for (auto &file : sources) file.make_preferred();
+        }
+      }
+      return targets;
+    }
+  }
 
-      task_run(command, target_files, check_files);
+  // Compiles the project source files into corresponding object files and selected headers into precompiled headers.
+  inline void compile()
+  {
+    for (auto &file : source_files) file.make_preferred();
+    for (auto &file : include_files) file.make_preferred();
+    for (auto &file : precompiled_headers) file.make_preferred();
+    for (auto &dir : external_include_directories) dir.make_preferred();
+    for (auto &dir : library_directories) dir.make_preferred();
+    for (auto &[header, sources] : precompiled_header_sources)
+    {
+      header.make_preferred();
+      for (auto &file : sources) file.make_preferred();
+    }
+
+    if (target_name.empty()) throw std::runtime_error("Executable name not set.");
+    if (source_files.empty()) throw std::runtime_error("No source files to compile.");
+
+    for (const bool headers : {true, false})
+    {
+      std::vector<utility::job> jobs{};
+      utility::for_each_configuration(
+        [&]()
+        {
+          auto item_jobs{utility::compile_plan(utility::global_target(), utility::build_directory, headers)};
+          jobs.insert(jobs.end(), std::make_move_iterator(item_jobs.begin()), std::make_move_iterator(item_jobs.end()));
+        });
+      utility::run_jobs(jobs);
+    }
+  }
+  /**
+   * Compiles the source files of multiple targets into object files and their selected headers into precompiled
+   * headers, scheduling every target's work into the same pass.
+   *
+   * Objects are written to "build/[configuration]/object/[hash]/[source directory]", where the hash covers every
+   * compile setting of a target; targets with identical settings share the directory, so a source file they have in
+   * common is only compiled once.
+   */
+  inline void compile(const std::vector<target> &targets)
+  {
+    const auto items{utility::preferred_targets(targets)};
+    for (const bool headers : {true, false})
+    {
+      std::vector<utility::job> jobs{};
+      utility::for_each_configuration(
+        [&]()
+        {
+          for (const auto &item : items)
+          {
+            auto item_jobs{utility::compile_plan(item, utility::object_directory(item), headers)};
+            jobs.insert(jobs.end(), std::make_move_iterator(item_jobs.begin()),
+                        std::make_move_iterator(item_jobs.end()));
+          }
+        });
+      utility::run_jobs(jobs);
     }
   }
 
+  // Links compiled object files into the final target artifact.
+  inline void link()
+  {
+    if (utility::build_directory.string().empty() || !std::filesystem::exists(utility::build_directory))
+      throw std::runtime_error("Link called before compile.");
+
+    std::vector<utility::job> partial_jobs{};
+    utility::for_each_configuration(
+      [&]()
+      {
+        auto item_jobs{utility::partial_link_plan(utility::global_target(), utility::build_directory)};
+        partial_jobs.insert(partial_jobs.end(), std::make_move_iterator(item_jobs.begin()),
+                            std::make_move_iterator(item_jobs.end()));
+      });
+    utility::run_jobs(partial_jobs);
+
+    std::vector<utility::job> jobs{};
+    utility::for_each_configuration(
+      [&]()
+      {
+        auto [command, target_files, check_files]{
+          utility::link_plan(utility::global_target(), utility::build_directory, utility::build_directory, {})};
+        if (utility::find_modified_files(target_files, check_files).empty()) return;
+        jobs.push_back({check_files.front(), check_files, [command]() { return command; }});
+      });
+    utility::run_jobs(jobs);
+
+    std::vector<utility::job> package_jobs{};
+    utility::for_each_configuration(
+      [&]()
+      {
+        auto item_jobs{utility::dwarf_package_plan(utility::global_target(), utility::build_directory)};
+        package_jobs.insert(package_jobs.end(), std::make_move_iterator(item_jobs.begin()),
+                            std::make_move_iterator(item_jobs.end()));
+      });
+    utility::run_jobs(package_jobs);
+  }
+  /**
+   * Links the compiled object files of multiple targets into their artifacts in "build/[configuration]".
+   *
+   * Targets are linked in dependency order, and targets that do not depend on each other are linked in parallel. A
+   * target links against the library artifacts of the targets named in its dependencies and is relinked when they
+   * change.
+   */
+  inline void link(const std::vector<target> &targets)
+  {
+    if (utility::build_directory.string().empty() || !std::filesystem::exists(utility::build_directory))
+      throw std::runtime_error("Link called before compile.");
+
+    const auto items{utility::preferred_targets(targets)};
+    std::vector<utility::job> partial_jobs{};
+    utility::for_each_configuration(
+      [&]()
+      {
+        for (const auto &item : items)
+        {
+          auto item_jobs{utility::partial_link_plan(item, utility::object_directory(item))};
+          partial_jobs.insert(partial_jobs.end(), std::make_move_iterator(item_jobs.begin()),
+                              std::make_move_iterator(item_jobs.end()));
+        }
+      });
+    utility::run_jobs(partial_jobs);
+
+    for (const auto &level : utility::target_levels(items))
+    {
+      std::vector<utility::job> jobs{};
+      utility::for_each_configuration(
+        [&]()
+        {
+          for (const auto *item : level)
+          {
+            std::vector<const target *> dependencies{};
+            for (const auto &name : item->dependencies)
+              dependencies.push_back(&*std::ranges::find(items, name, &target::name));
+            auto [command, target_files, check_files]{
+              utility::link_plan(*item, utility::object_directory(*item), utility::build_directory, dependencies)};
+            if (utility::find_modified_files(target_files, check_files).empty()) continue;
+            jobs.push_back({check_files.front(), check_files, [command]() { return command; }});
+          }
+        });
+      utility::run_jobs(jobs);
+    }
+
+    std::vector<utility::job> package_jobs{};
+    utility::for_each_configuration(
+      [&]()
+      {
+        for (const auto &item : items)
+        {
+          auto item_jobs{utility::dwarf_package_plan(item, utility::build_directory)};
+          package_jobs.insert(package_jobs.end(), std::make_move_iterator(item_jobs.begin()),
+                              std::make_move_iterator(item_jobs.end()));
+        }
+      });
+    utility::run_jobs(package_jobs);
+  }
+
   /**
    * Runs the built executable target with optional arguments.
    *
    * This function's parameters behave as follows:
+   * | `item`: The target whose executable is run from the active configuration's build directory.
    * | `target_arguments`: The arguments to pass to the executable. They can be provided as a string, a vector of
    *                       strings, or functions that return either of those types.
    */
-  inline void run_target(const std::variant<std::string, std::vector<std::string>, std::function<std::string()>,
+  inline void run_target(const target &item,
+                         const std::variant<std::string, std::vector<std::string>, std::function<std::string()>,
                                             std::function<std::vector<std::string>()>> &target_arguments = {})
   {
-    if (target_artifact != EXECUTABLE) throw std::runtime_error("Target artifact is not an executable.");
+    if (item.artifact_type != EXECUTABLE) throw std::runtime_error("Target artifact is not an executable.");
     const std::filesystem::path executable_path{std::format(
       "{}{}{}", (host_platform == LINUX ? "./" : ""),
-      (std::filesystem::path("build") / (target_configuration == RELEASE ? "release" : "debug") / target_name).string(),
+      (configuration_directory() / item.name).string(),
       (host_platform == WINDOWS ? ".exe" : ""))};
     if (!std::filesystem::exists(executable_path))
       throw std::runtime_error("Executable does not exist: " + executable_path.string() + ".");
@@ -31863,9 +35183,221 @@ namespace csb
                     utility::small_section_divider(), return_code);
       });
   }
+  // Runs the built executable of the global target settings with optional arguments.
+  inline void run_target(const std::variant<std::string, std::vector<std::string>, std::function<std::string()>,
+                                            std::function<std::vector<std::string>()>> &target_arguments = {})
+  { run_target(utility::global_target(), target_arguments); }
 
   constexpr auto success{EXIT_SUCCESS};
   constexpr auto failure{EXIT_FAILURE};
+  namespace utility
+  {
+    // Resolves the configurations selected on the command line against those defined by configure.
+    inline void resolve_configurations()
+    {
+      if (is_subproject)
+      {
+        configuration_names = split_configuration_names(
+          strict_get_env("CSB_TARGET_CONFIGURATION", "Subproject detected with no CSB_TARGET_CONFIGURATION"));
+        inherited_configurations.clear();
+        if (const auto definitions{get_environment_variable("CSB_CONFIGURATION_DEFINITIONS")}; !definitions.empty())
+          for (const auto &item : nlohmann::json::parse(definitions))
+            inherited_configurations.push_back(json_configuration(item));
+      }
+      build_configurations.clear();
+      for (const auto &name : configuration_names) build_configurations.push_back(find_configuration(name));
+      if (build_configurations.empty()) build_configurations.push_back(target_configuration);
+      target_configuration = build_configurations.front();
+      if (!is_subproject)
+      {
+        std::string names{};
+        for (const auto &item : build_configurations) names += (names.empty() ? "" : ",") + item.name;
+        std::ranges::transform(names, names.begin(), [](const unsigned char character)
+                               { return static_cast<char>(std::toupper(character)); });
+        set_environment_variable("CSB_TARGET_CONFIGURATION", names);
+        auto definitions{nlohmann::json::array()};
+        for (const auto &item : build_configurations) definitions.push_back(configuration_json(item));
+        set_environment_variable("CSB_CONFIGURATION_DEFINITIONS", definitions.dump());
+      }
+    }
+
+    // Runs configure and resolves the selected configurations and shared settings that depend on it.
+    inline void configure_project()
+    {
+      // Installs add to these when building, so a daemon or watch session starts every configure from the originals.
+      static const std::tuple initial{external_include_directories, library_directories,
+                                      get_environment_variable("PATH")};
+      external_include_directories = std::get<0>(initial);
+      library_directories = std::get<1>(initial);
+      set_environment_variable("PATH", std::get<2>(initial));
+      utility::subproject_builds.clear();
+      configure();
+      if (precompiled_header_store.empty())
+        precompiled_header_store = get_environment_variable("CSB_PRECOMPILED_HEADER_STORE");
+      else
+        set_environment_variable("CSB_PRECOMPILED_HEADER_STORE",
+                                 std::filesystem::absolute(precompiled_header_store).string());
+      resolve_configurations();
+    }
+
+    /**
+     * Builds the project and then rebuilds it whenever a file it read changes, running it after each build when
+     * `then_run` is set. Configuration and settings stay in memory between builds; configure runs again only when
+     * files are created, deleted or moved in a watched directory, as globs may then pick up different files.
+     *
+     * Watched directories are those holding the inputs that the last build's up to date checks read, such as sources,
+     * headers from dependency files and embedded resources, along with "csb" and directories created inside watched
+     * ones. Watches stay in place while building, so saves made during a build start another one. Anything under
+     * "build" is ignored. When the build script changes, watching stops so that csb can be rebuilt.
+     */
+    inline int watch(const bool then_run)
+    {
+      watching = true;
+      const auto script_time{build_script_time()};
+      const auto build_root{std::filesystem::absolute("build").lexically_normal()};
+      auto ignored{[&build_root](const std::filesystem::path &path)
+                   {
+                     const auto absolute_path{std::filesystem::absolute(path).lexically_normal()};
+                     const auto name{absolute_path.filename().string()};
+                     if (name.starts_with('.') || name.ends_with('~')) return true;
+                     return std::ranges::mismatch(build_root, absolute_path).in1 == build_root.end();
+                   }};
+
+      change_watcher watcher{};
+      while (true)
+      {
+        {
+          const std::scoped_lock<std::mutex> lock(watched_inputs_mutex);
+          watched_inputs = {};
+        }
+        const auto started{std::filesystem::file_time_type::clock::now()};
+        try
+        {
+          csb::build();
+          if (then_run) csb::run();
+        }
+        catch (const std::exception &exception)
+        {
+          print<CERR>("{}\n", exception.what());
+        }
+
+        path_set directories{};
+        directories.insert("csb");
+        for (const auto &input : watched_inputs.paths)
+        {
+          const auto directory{input.has_parent_path() ? input.parent_path() : std::filesystem::path{"."}};
+          if (!ignored(input) && std::filesystem::is_directory(directory)) directories.insert(directory);
+        }
+        watcher.watch(directories.paths);
+        print<COUT>("\nWatching {} directories for changes...\n", directories.paths.size());
+
+        // Directories first watched now missed any saves made during the build, so their inputs are checked once.
+        const auto input_times{file_write_times(watched_inputs.paths)};
+        bool changed{};
+        for (std::size_t index{}; index < input_times.size() && !changed; ++index)
+        {
+          const auto &time{input_times.at(index)};
+          changed = time && *time > started && !ignored(watched_inputs.paths.at(index));
+        }
+        bool reconfigure{};
+        while (true)
+        {
+          if (build_script_time() != script_time)
+          {
+            print<COUT>("\nThe build script changed, rebuild csb to keep watching.\n");
+            return success;
+          }
+          if (changed) break;
+          for (const auto &[path, structural] : watcher.wait(std::chrono::milliseconds{100}))
+          {
+            if (ignored(path)) continue;
+            if (structural) reconfigure = true;
+            if (structural || watched_inputs.contains(path)) changed = true;
+          }
+        }
+        if (!reconfigure) continue;
+        try
+        {
+          configure_project();
+        }
+        catch (const std::exception &exception)
+        {
+          print<CERR>("{}\n", exception.what());
+        }
+      }
+    }
+
+    // The name of the socket the daemon for the project in the current directory listens on.
+    inline std::string daemon_socket_name()
+    {
+      const auto project{std::filesystem::absolute(std::filesystem::current_path()).lexically_normal().string()};
+      return std::format("csb-daemon-{:016x}", std::hash<std::string>{}(project));
+    }
+
+    /**
+     * Starts a background process that serves clean, build and run requests from later invocations of csb in this
+     * directory, skipping process startup for each of them. Every request runs configure again with its own arguments,
+     * so added or removed source files are picked up, while cached directory listings keep that cheap. Requests are
+     * served one at a time with the client's standard streams, while the environment is the one the daemon was started
+     * with. The daemon exits, leaving the request to the client, once the build script or the csb binary changes, and a
+     * request of `csb daemon stop` stops it.
+     */
+    inline int daemon()
+    {
+      terminal_width();
+      if (!detach_process())
+      {
+        print<COUT>("Started the csb daemon for this project.\n");
+        return success;
+      }
+
+      try
+      {
+        const auto script_time{build_script_time()};
+        const auto binary{std::filesystem::read_symlink("/proc/self/exe")};
+        const auto binary_time{std::filesystem::last_write_time(binary)};
+        serve_requests(daemon_socket_name(),
+                       [&](const std::vector<std::string> &args) -> std::pair<int, bool>
+                       {
+                         std::error_code error{};
+                         if (build_script_time() != script_time || std::filesystem::last_write_time(binary, error) !=
+                                                                     binary_time)
+                           return {-1, true};
+                         current_task = {};
+                         watch_requested = false;
+                         daemon_requested = false;
+                         configuration_names.clear();
+                         arguments.clear();
+                         try
+                         {
+                           handle_arguments(std::vector<std::string_view>(args.begin(), args.end()));
+                           if (daemon_requested) return {success, true};
+                           configure_project();
+                           if (current_task == CLEAN)
+                             return {csb::clean(), false};
+                           else if (current_task == BUILD)
+                             return {csb::build(), false};
+                           else if (current_task == RUN)
+                             return {csb::run(), false};
+                           else
+                             throw std::runtime_error("No task specified.");
+                         }
+                         catch (const std::exception &exception)
+                         {
+                           print<CERR>("{}\n", exception.what());
+                           return {failure, false};
+                         }
+                       });
+      }
+      catch (const std::exception &exception)
+      {
+        print<CERR>("{}\n", exception.what());
+        return failure;
+      }
+      return success;
+    }
+  }
+
   inline int entry(const int argc, char **argv)
   {
     try
@@ -31891,16 +35423,20 @@ namespace csb
       csb::utility::handle_arguments(std::vector<std::string_view>(args.begin(), args.end()));
       csb::utility::setup_environment_variables();
       if (!csb::get_environment_variable("CSB_TARGET_CONFIGURATION").empty()) csb::is_subproject = true;
-      csb::configure();
-      if (csb::is_subproject)
-        csb::target_configuration =
-          csb::utility::strict_get_env("CSB_TARGET_CONFIGURATION",
-                                       "Subproject detected with no CSB_TARGET_CONFIGURATION") == "RELEASE"
-            ? RELEASE
-            : DEBUG;
-      else
-        csb::set_environment_variable("CSB_TARGET_CONFIGURATION",
-                                      csb::target_configuration == RELEASE ? "RELEASE" : "DEBUG");
+      if (!csb::is_subproject && !csb::utility::watch_requested)
+      {
+        const auto code{
+          delegate_request(csb::utility::daemon_socket_name(), std::vector<std::string>(args.begin(), args.end()))};
+        if (code && !csb::utility::daemon_requested) return *code;
+        if (csb::utility::daemon_requested)
+          return csb::contains(csb::arguments, std::string{"stop"}) ? csb::success : csb::utility::daemon();
+      }
+      csb::utility::configure_project();
+      if (csb::utility::watch_requested)
+      {
+        if (csb::utility::current_task == CLEAN) throw std::runtime_error("Watch cannot be combined with clean.");
+        return csb::utility::watch(csb::utility::current_task == RUN);
+      }
       if (csb::utility::current_task == CLEAN)
         return csb::clean();
       else if (csb::utility::current_task == BUILD)